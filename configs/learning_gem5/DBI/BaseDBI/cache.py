@@ -9,7 +9,7 @@ line options from each individual class.
 
 import m5
 from m5.objects import Cache
-from m5.objects import Toy
+from m5.objects import DBICache
 
 # Add the common scripts to our path
 m5.util.addToPath('../../')
@@ -19,8 +19,10 @@ from common import SimpleOpts
 # Some specific options for caches
 # For all options see src/mem/cache/BaseCache.py
 
-SimpleOpts.add_option('-n', help=" " )  
-SimpleOpts.add_option('-t', help=" " )
+SimpleOpts.add_option('-n', '--nums', default='2',
+                      help="Number of elements in each array. Default: 2")
+SimpleOpts.add_option('-t', '--iterations', default='1',
+                      help="Number of iterations. Default: 1")
 
 class L1Cache(Cache):
     """Simple L1 Cache with default values"""
@@ -109,3 +111,56 @@ class L2Cache(Cache):
 
     def connectMemSideBus(self, bus):
         self.mem_side = bus.cpu_side_ports
+
+class L2DBICache(DBICache):
+    """L2 Cache with a DBI, with the same default values as L2Cache"""
+
+    # Default parameters
+    size = '4MB'
+    blkSize = '64'
+    assoc = 8
+    tag_latency = 20
+    data_latency = 20
+    response_latency = 20
+    mshrs = 20
+    tgts_per_mshr = 12
+
+    # Default DBI parameters
+    alpha = 0.25
+    dbi_assoc = 2
+    blk_per_dbi_entry = 64
+    aggr_writeback = False
+
+    SimpleOpts.add_option('--alpha', type=float,
+                          help="Size of the DBI relative to the cache. "
+                               "Default: %s" % alpha)
+    SimpleOpts.add_option('--dbi_assoc', type=int,
+                          help="Associativity of the DBI. Default: %s"
+                               % dbi_assoc)
+    SimpleOpts.add_option('--blk_per_dbi_entry', type=int,
+                          help="Cache blocks per DBI entry. Default: %s"
+                               % blk_per_dbi_entry)
+    SimpleOpts.add_option('--aggr_writeback', type=int, choices=[0, 1],
+                          help="Use aggressive writeback. Default: %d"
+                               % aggr_writeback)
+
+    def __init__(self, opts=None):
+        super(L2DBICache, self).__init__()
+        if not opts:
+            return
+        if opts.l2_size:
+            self.size = opts.l2_size
+        if opts.alpha is not None:
+            self.alpha = opts.alpha
+        if opts.dbi_assoc is not None:
+            self.dbi_assoc = opts.dbi_assoc
+        if opts.blk_per_dbi_entry is not None:
+            self.blk_per_dbi_entry = opts.blk_per_dbi_entry
+        if opts.aggr_writeback is not None:
+            self.aggr_writeback = bool(opts.aggr_writeback)
+
+    def connectCPUSideBus(self, bus):
+        self.cpu_side = bus.mem_side_ports
+
+    def connectMemSideBus(self, bus):
+        self.mem_side = bus.cpu_side_ports
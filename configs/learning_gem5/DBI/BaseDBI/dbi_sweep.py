@@ -0,0 +1,168 @@
+""" Design-space sweep of the DBI of the two_level.py system
+
+This script is run with python3, not with gem5. It runs two_level.py with
+--dbi once for each combination of the swept DBI parameters and L2 sizes.
+The gem5 processes run in parallel, one per local core by default. Each
+run writes its own output directory. The write row hit rate, DRAM write
+bandwidth and IPC of every run are collected from its stats.txt into a
+single CSV.
+
+Example:
+
+    python3 configs/learning_gem5/DBI/BaseDBI/dbi_sweep.py \\
+        build/X86/gem5.opt configs/learning_gem5/DBI/BaseDBI/add \\
+        --alpha 0.25,0.5 --dbi_assoc 2,4 --blk_per_dbi_entry 32,64 \\
+        --aggr_writeback 0,1 --l2_size 1MB,4MB -n 100000
+
+Runs whose stats.txt already exists are not run again, so an interrupted
+sweep can be restarted with the same command.
+"""
+
+import argparse
+import csv
+import itertools
+import os
+import subprocess
+import sys
+from concurrent.futures import ThreadPoolExecutor
+
+thispath = os.path.dirname(os.path.realpath(__file__))
+
+# Swept parameters, in the order of the CSV columns and output directories
+sweep_params = ['alpha', 'dbi_assoc', 'blk_per_dbi_entry', 'aggr_writeback',
+                'l2_size']
+
+# CSV columns taken from the stats, and the stats they are taken from
+stat_columns = [
+    ('write_row_hit_rate', 'system.mem_ctrl.dram.writeRowHitRate'),
+    ('dram_write_bw', 'system.mem_ctrl.dram.avgWrBW'),
+    ('sim_insts', 'simInsts'),
+    ('num_cycles', 'system.cpu.numCycles'),
+]
+
+def parse_list(value):
+    """Split a comma separated list of values"""
+    return [v for v in value.split(',') if v]
+
+def parse_stats(path):
+    """Read the stats of the last dump of a stats.txt file"""
+    stats = {}
+    with open(path) as f:
+        for line in f:
+            if line.startswith('---------- Begin Simulation Statistics'):
+                stats = {}
+                continue
+            fields = line.split()
+            if len(fields) < 2 or fields[0].startswith('#'):
+                continue
+            stats[fields[0]] = fields[1]
+    return stats
+
+def run_name(point):
+    """Name of the output directory of a sweep point"""
+    return '_'.join('%s-%s' % (name, point[name]) for name in sweep_params)
+
+def run_point(args, point):
+    """Run gem5 for a sweep point, unless it already has its stats"""
+    outdir = os.path.join(args.outdir, run_name(point))
+    stats_file = os.path.join(outdir, 'stats.txt')
+    if os.path.exists(stats_file):
+        return point, outdir, 0
+
+    os.makedirs(outdir, exist_ok=True)
+    cmd = [args.gem5, '--outdir=%s' % outdir,
+           os.path.join(thispath, 'two_level.py'), args.binary, '--dbi',
+           '-n', args.nums, '-t', args.iterations]
+    for name in sweep_params:
+        cmd.append('--%s=%s' % (name, point[name]))
+
+    with open(os.path.join(outdir, 'gem5.log'), 'w') as log:
+        status = subprocess.call(cmd, stdout=log, stderr=subprocess.STDOUT)
+    # A failed run must not be taken as done when the sweep is restarted
+    if status != 0 and os.path.exists(stats_file):
+        os.rename(stats_file, stats_file + '.failed')
+    return point, outdir, status
+
+def collect(point, outdir, status):
+    """Make the CSV row of a sweep point"""
+    row = dict(point)
+    row['status'] = status
+    stats_file = os.path.join(outdir, 'stats.txt')
+    stats = parse_stats(stats_file) if os.path.exists(stats_file) else {}
+    for column, stat in stat_columns:
+        row[column] = stats.get(stat, '')
+    try:
+        row['ipc'] = float(row['sim_insts']) / float(row['num_cycles'])
+    except (ValueError, ZeroDivisionError):
+        row['ipc'] = ''
+    return row
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Sweep the DBI parameters of two_level.py.')
+    parser.add_argument('gem5', help="Path to the gem5 binary.")
+    parser.add_argument('binary', help="Path to the binary to simulate.")
+    parser.add_argument('--alpha', type=parse_list, default=['0.25'],
+                        help="Comma separated DBI sizes. Default: 0.25")
+    parser.add_argument('--dbi_assoc', type=parse_list, default=['2'],
+                        help="Comma separated DBI associativities. "
+                             "Default: 2")
+    parser.add_argument('--blk_per_dbi_entry', type=parse_list,
+                        default=['64'],
+                        help="Comma separated cache blocks per DBI entry. "
+                             "Default: 64")
+    parser.add_argument('--aggr_writeback', type=parse_list, default=['0'],
+                        help="Comma separated aggressive writeback "
+                             "settings, 0 or 1. Default: 0")
+    parser.add_argument('--l2_size', type=parse_list, default=['4MB'],
+                        help="Comma separated L2 cache sizes. Default: 4MB")
+    parser.add_argument('-n', '--nums', default='2',
+                        help="Number of elements in each array. Default: 2")
+    parser.add_argument('-t', '--iterations', default='1',
+                        help="Number of iterations. Default: 1")
+    parser.add_argument('-j', '--jobs', type=int, default=os.cpu_count(),
+                        help="Number of gem5 processes to run in parallel. "
+                             "Default: number of cores")
+    parser.add_argument('--outdir', default='dbi_sweep',
+                        help="Directory of the run outputs. "
+                             "Default: dbi_sweep")
+    parser.add_argument('--csv', default=None,
+                        help="Path of the CSV file. "
+                             "Default: <outdir>/results.csv")
+    args = parser.parse_args()
+
+    for value in args.aggr_writeback:
+        if value not in ('0', '1'):
+            parser.error("aggr_writeback must be 0 or 1, not %s" % value)
+
+    points = [dict(zip(sweep_params, values))
+              for values in itertools.product(
+                  *(getattr(args, name) for name in sweep_params))]
+    print("Running %d configurations, %d at a time" %
+          (len(points), args.jobs))
+
+    rows = []
+    with ThreadPoolExecutor(max_workers=args.jobs) as executor:
+        futures = [executor.submit(run_point, args, point)
+                   for point in points]
+        for future in futures:
+            point, outdir, status = future.result()
+            if status != 0:
+                print("%s failed with status %d, see %s" %
+                      (run_name(point), status,
+                       os.path.join(outdir, 'gem5.log')))
+            rows.append(collect(point, outdir, status))
+
+    csv_path = args.csv or os.path.join(args.outdir, 'results.csv')
+    columns = (sweep_params + [column for column, _ in stat_columns] +
+               ['ipc', 'status'])
+    with open(csv_path, 'w', newline='') as f:
+        writer = csv.DictWriter(f, fieldnames=columns)
+        writer.writeheader()
+        writer.writerows(rows)
+    print("Results written to %s" % csv_path)
+
+    return 0 if all(row['status'] == 0 for row in rows) else 1
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,153 @@
+""" DBI microbenchmark driven by the traffic generator
+
+A DBIGen traffic generator writes region-clustered streams straight into
+an L2DBICache, which is backed by a DDR3 memory controller. No CPU model
+is simulated, so the behaviour of the DBI for a given dirty density,
+region reuse distance and read/write mix is measured in seconds.
+
+Example:
+
+    build/X86/gem5.opt configs/learning_gem5/DBI/BaseDBI/dbi_traffic.py \\
+        --dirty_density 25 --reuse_distance 64 --reuse_percent 90 \\
+        --rd_perc 30 --alpha 0.25 --blk_per_dbi_entry 64
+
+With --writeback_l1, the generator writes through an L1 data cache, so
+that the L2 mostly receives writebacks, as a last-level cache does.
+--check_idle_writeback then checks that the idle-time writeback engine
+cleaned some blocks, and exits with status 1 otherwise:
+
+    build/X86/gem5.opt configs/learning_gem5/DBI/BaseDBI/dbi_traffic.py \\
+        --writeback_l1 --l1d_size 4kB --check_idle_writeback
+"""
+
+import os
+import sys
+
+# import the m5 (gem5) library created when gem5 is built
+import m5
+# import all of the SimObjects
+from m5.objects import *
+
+# Add the common scripts to our path
+m5.util.addToPath('../../')
+
+# import the caches which we made
+from cache import *
+
+# import the SimpleOpts module
+from common import SimpleOpts
+
+SimpleOpts.add_option("--region_size", type=int, default=None,
+                      help="Size of a region in bytes. "
+                           "Default: the memory tracked by a DBI entry")
+SimpleOpts.add_option("--dirty_density", type=int, default=50,
+                      help="Percent of the blocks of a region written on "
+                           "each visit. Default: 50")
+SimpleOpts.add_option("--reuse_distance", type=int, default=16,
+                      help="Number of other regions visited between two "
+                           "visits of a region. Default: 16")
+SimpleOpts.add_option("--reuse_percent", type=int, default=75,
+                      help="Percent of visits after which a region is "
+                           "visited again. Default: 75")
+SimpleOpts.add_option("--rd_perc", type=int, default=0,
+                      help="Percent of the requests that are reads. "
+                           "Default: 0")
+SimpleOpts.add_option("--period", type=int, default=1000,
+                      help="Ticks between two requests. Default: 1000")
+SimpleOpts.add_option("--duration", default='1ms',
+                      help="Simulated time. Default: 1ms")
+SimpleOpts.add_option("--writeback_l1", action='store_true',
+                      help="Write through an L1 data cache, so that the L2 "
+                           "receives writebacks")
+SimpleOpts.add_option("--idle_writeback", action='store_true',
+                      help="Enable the idle-time writeback engine of the L2")
+SimpleOpts.add_option("--check_idle_writeback", action='store_true',
+                      help="Enable the idle-time writeback engine, and fail "
+                           "if it did not write back any block")
+
+# Finalize the arguments and grab the args so we can pass it on to our objects
+args = SimpleOpts.parse_args()
+
+# create the system we are going to simulate
+system = System()
+
+# Set the clock frequency of the system (and all of its children)
+system.clk_domain = SrcClockDomain()
+system.clk_domain.clock = '1GHz'
+system.clk_domain.voltage_domain = VoltageDomain()
+
+# Set up the system
+system.mem_mode = 'timing'               # Use timing accesses
+system.mem_ranges = [AddrRange('512MB')] # Create an address range
+
+# Create the traffic generator and the L2 cache with a DBI it writes to
+system.tgen = PyTrafficGen()
+system.l2cache = L2DBICache(args)
+if args.idle_writeback or args.check_idle_writeback:
+    system.l2cache.idle_writeback_enable = True
+if args.writeback_l1:
+    system.l1dcache = L1DCache(args)
+    system.l1dcache.cpu_side = system.tgen.port
+    system.l1dcache.mem_side = system.l2cache.cpu_side
+else:
+    system.l2cache.cpu_side = system.tgen.port
+
+# Create a memory bus
+system.membus = SystemXBar()
+
+# Connect the L2 cache to the membus
+system.l2cache.connectMemSideBus(system.membus)
+
+# Connect the system up to the membus
+system.system_port = system.membus.cpu_side_ports
+
+# Create a DDR3 memory controller
+system.mem_ctrl = MemCtrl()
+system.mem_ctrl.dram = DDR3_1600_8x8()
+system.mem_ctrl.dram.range = system.mem_ranges[0]
+system.mem_ctrl.port = system.membus.mem_side_ports
+
+# set up the root SimObject and start the simulation
+root = Root(full_system = False, system = system)
+# instantiate all of the objects we've created above
+m5.instantiate()
+
+blk_size = system.cache_line_size.value
+region_size = args.region_size or \
+    system.l2cache.blk_per_dbi_entry.value * blk_size
+duration = m5.ticks.fromSeconds(m5.util.convert.anyToLatency(args.duration))
+
+def trace():
+    yield system.tgen.createDBI(duration,
+                                0, system.mem_ranges[0].end, blk_size,
+                                region_size, args.dirty_density,
+                                args.reuse_distance, args.reuse_percent,
+                                args.period, args.period,
+                                args.rd_perc, 0)
+    # Leave the memory side idle for a few periods of the engine, of 1ns
+    # cycles
+    if args.check_idle_writeback:
+        yield system.tgen.createIdle(
+            10 * system.l2cache.idle_writeback_period.value *
+            m5.ticks.fromSeconds(1e-9))
+    yield system.tgen.createExit(0)
+
+system.tgen.start(trace())
+
+print("Beginning simulation!")
+exit_event = m5.simulate()
+print('Exiting @ tick %i because %s' % (m5.curTick(), exit_event.getCause()))
+
+if args.check_idle_writeback:
+    m5.stats.dump()
+    stat = 'system.l2cache.idleWritebackBlks'
+    idle_blks = 0
+    with open(os.path.join(m5.options.outdir, 'stats.txt')) as f:
+        for line in f:
+            fields = line.split()
+            if len(fields) > 1 and fields[0] == stat:
+                idle_blks = float(fields[1])
+    print("%s: %d" % (stat, idle_blks))
+    if idle_blks == 0:
+        print("The idle-time writeback engine did not write back any block")
+        sys.exit(1)
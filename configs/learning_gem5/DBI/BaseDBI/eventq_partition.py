@@ -0,0 +1,150 @@
+""" Automatic partitioning of a system over event queues
+
+gem5 can simulate a system with several event queues, one thread each,
+which synchronise once per simulation quantum (Root.sim_quantum). Objects
+that call each other through ports must be on the same event queue,
+except across a MailboxBridge, whose two sides may be on different
+queues as long as its delay is larger than the quantum.
+
+partition() splits the objects connected by ports into islands, which
+only MailboxBridges connect, and spreads the islands over the event
+queues. The island of the System stays on queue 0, the others are
+balanced by their number of CPUs, then by their number of objects. The
+objects of an island are given the event queue of the island, the
+objects without ports inherit it from their parent. Each MailboxBridge
+is given the event queue of its memory side.
+
+Only port connections are followed. Objects that call each other
+through parameters are only kept on the same queue if ports connect
+them as well.
+
+Coherent crossbars cannot be split this way, as their snoops are
+answered within the call that sends them, and a MailboxBridge carries no
+snoops. So the cores of a coherent system, their private caches and the
+crossbar joining them stay on one queue: a 16 or 32 core system does not
+run its cores in parallel. Only what sits behind a non-coherent
+boundary, such as the memory controllers below the point of coherence,
+or independent systems, can be moved to other queues.
+
+Example, with the memory controller behind a MailboxBridge:
+
+    system.mem_bridge = MailboxBridge(delay='20ns',
+                                      ranges=system.mem_ranges)
+    system.mem_bridge.cpu_side_port = system.membus.mem_side_ports
+    system.mem_ctrl.port = system.mem_bridge.mem_side_port
+    root = Root(full_system=False, system=system)
+    partition(root, num_queues=2, quantum=10000)
+"""
+
+from m5.objects import BaseCPU, MailboxBridge, System
+from m5.params import VectorPortRef
+from m5.proxy import isproxy
+
+def _connections(obj):
+    """Yield the connected ports of an object, with their peers"""
+    for ref in obj._port_refs.values():
+        refs = ref.elements if isinstance(ref, VectorPortRef) else [ref]
+        for port in refs:
+            if port.peer is not None and not isproxy(port.peer):
+                yield port, port.peer
+
+def _crosses_queues(port, peer):
+    """Check if a connection may join objects of different event queues"""
+    # The CPU side of a MailboxBridge is on the queue of the bridge
+    return ((isinstance(port.simobj, MailboxBridge) and
+             port.name == 'mem_side_port') or
+            (isinstance(peer.simobj, MailboxBridge) and
+             peer.name == 'mem_side_port'))
+
+def islands(root):
+    """Group the objects connected by ports, other than through the
+    memory side of a MailboxBridge"""
+    parent = {}
+
+    def find(obj):
+        while parent[id(obj)] is not obj:
+            parent[id(obj)] = parent[id(parent[id(obj)])]
+            obj = parent[id(obj)]
+        return obj
+
+    objects = []
+    for obj in root.descendants():
+        connections = list(_connections(obj))
+        if not connections:
+            continue
+        if id(obj) not in parent:
+            parent[id(obj)] = obj
+            objects.append(obj)
+        for port, peer in connections:
+            if _crosses_queues(port, peer):
+                continue
+            if id(peer.simobj) not in parent:
+                parent[id(peer.simobj)] = peer.simobj
+                objects.append(peer.simobj)
+            a, b = find(obj), find(peer.simobj)
+            if a is not b:
+                parent[id(a)] = b
+
+    groups = {}
+    for obj in objects:
+        groups.setdefault(id(find(obj)), []).append(obj)
+    return list(groups.values())
+
+def _load(island):
+    """Weight of an island: its number of CPUs, then of objects"""
+    return (sum(isinstance(obj, BaseCPU) for obj in island), len(island))
+
+def partition(root, num_queues, quantum):
+    """Assign the objects of root to num_queues event queues
+
+    quantum is the simulation quantum, in ticks. The delay of every
+    MailboxBridge whose sides end up on different queues must be larger.
+    Returns the islands assigned to each queue.
+    """
+    if num_queues < 1:
+        raise ValueError("At least one event queue is needed")
+
+    queues = [[] for _ in range(num_queues)]
+    loads = [(0, 0)] * num_queues
+
+    def assign(index, island):
+        queues[index].append(island)
+        loads[index] = tuple(x + y for x, y in zip(loads[index],
+                                                   _load(island)))
+
+    # The System stays on the first queue, then the largest islands go
+    # first, each one on the least loaded queue
+    pending = []
+    for island in sorted(islands(root), key=_load, reverse=True):
+        if any(isinstance(obj, System) for obj in island):
+            assign(0, island)
+        else:
+            pending.append(island)
+    for island in pending:
+        assign(min(range(num_queues), key=lambda i: loads[i]), island)
+
+    queue_of = {}
+    for index, queue in enumerate(queues):
+        for island in queue:
+            for obj in island:
+                obj.eventq_index = index
+                queue_of[id(obj)] = index
+
+    for island in (island for queue in queues for island in queue):
+        for obj in island:
+            if not isinstance(obj, MailboxBridge):
+                continue
+            for port, peer in _connections(obj):
+                if port.name == 'mem_side_port':
+                    obj.mem_side_eventq_index = queue_of[id(peer.simobj)]
+
+    if num_queues > 1:
+        root.sim_quantum = quantum
+
+    return queues
+
+def describe(queues):
+    """Print the objects on each event queue"""
+    for index, queue in enumerate(queues):
+        names = sorted(obj.path() for island in queue for obj in island)
+        print("Event queue %d: %s" % (index, ', '.join(names) or '(empty)'))
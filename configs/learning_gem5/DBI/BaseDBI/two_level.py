@@ -10,6 +10,9 @@ m5.util.addToPath('../../')
 # import the caches which we made
 from cache import *
 
+# import the event queue partitioner
+from eventq_partition import partition, describe
+
 # import the SimpleOpts module
 from common import SimpleOpts
 
@@ -28,6 +31,27 @@ default_binary = sys.argv[1]
 # Binary to execute
 SimpleOpts.add_option("binary", nargs='?', default=default_binary)
 
+# Use a DBI in the L2 cache, configured by the L2DBICache options
+SimpleOpts.add_option("--dbi", action='store_true',
+                      help="Use an L2 cache with a DBI")
+
+# Simulate the memory controller behind a MailboxBridge, and spread the
+# system over this many event queues
+SimpleOpts.add_option("--event_queues", type=int, default=0,
+                      help="Number of event queues, 0 to connect the "
+                           "memory controller directly. Default: 0")
+SimpleOpts.add_option("--sim_quantum", type=int, default=10000,
+                      help="Simulation quantum in ticks, with more than "
+                           "one event queue. Default: 10000")
+SimpleOpts.add_option("--mailbox_delay", default='20ns',
+                      help="Delay of the MailboxBridge, larger than the "
+                           "quantum. Default: 20ns")
+
+# Structure sorting the events of the event queues
+SimpleOpts.add_option("--eventq_backend", default='list',
+                      choices=['list', 'calendar'],
+                      help="Backend of the event queues. Default: list")
+
 # Finalize the arguments and grab the args so we can pass it on to our objects
 args = SimpleOpts.parse_args()
 
@@ -62,7 +86,10 @@ system.cpu.icache.connectBus(system.l2bus)
 system.cpu.dcache.connectBus(system.l2bus)
 
 # Create an L2 cache and connect it to the l2bus
-system.l2cache = L2Cache(args)
+if args.dbi:
+    system.l2cache = L2DBICache(args)
+else:
+    system.l2cache = L2Cache(args)
 system.l2cache.connectCPUSideBus(system.l2bus)
 
 # Create a memory bus
@@ -88,7 +115,14 @@ system.system_port = system.membus.cpu_side_ports
 system.mem_ctrl = MemCtrl()
 system.mem_ctrl.dram = DDR3_1600_8x8()
 system.mem_ctrl.dram.range = system.mem_ranges[0]
-system.mem_ctrl.port = system.membus.mem_side_ports
+if args.event_queues:
+    # The memory controller may run on its own event queue
+    system.mem_bridge = MailboxBridge(delay=args.mailbox_delay,
+                                      ranges=system.mem_ranges)
+    system.mem_bridge.cpu_side_port = system.membus.mem_side_ports
+    system.mem_ctrl.port = system.mem_bridge.mem_side_port
+else:
+    system.mem_ctrl.port = system.membus.mem_side_ports
 
 system.workload = SEWorkload.init_compatible(args.binary)
 
@@ -100,29 +134,15 @@ process.cmd = [args.binary]
 # Set the cpu to use the process as its workload and create thread contexts
 system.cpu.workload = process
 system.cpu.createThreads()
-import argparse
-
-parser = argparse.ArgumentParser(description='A simple system with 3-level cache.')
-parser.add_argument("binary", default="", nargs="?", type=str,
-                    help="Path to the binary to execute.")
-parser.add_argument("--l1i_size",
-                    help=f"L1 instruction cache size. Default: 16kB.")
-parser.add_argument("--l1d_size",
-                    help="L1 data cache size. Default: Default: 64kB.")
-parser.add_argument("--l2_size",
-                    help="L2 cache size. Default: 256kB.")
-parser.add_argument("--l3_size",
-                    help="L2 cache size. Default: 4096kB.")
-parser.add_argument("-n", "--nums", type=int, help="number of elements in each array", default="2")
-parser.add_argument("-t", "--iterations", type=int, help="number of iterations", default="1")
-
-options = parser.parse_args()
 
 # cmd is a list which begins with the executable (like argv)
-process.cmd = [args.binary, '-n', options.nums, '-i', "bo", '-t', options.iterations]
+process.cmd = [args.binary, '-n', args.nums, '-i', "bo", '-t', args.iterations]
 
 # set up the root SimObject and start the simulation
-root = Root(full_system = False, system = system)
+root = Root(full_system = False, system = system,
+            eventq_backend = args.eventq_backend)
+if args.event_queues:
+    describe(partition(root, args.event_queues, args.sim_quantum))
 # instantiate all of the objects we've created above
 m5.instantiate()
 
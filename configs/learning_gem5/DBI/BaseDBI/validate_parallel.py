@@ -0,0 +1,145 @@
+""" Validate a parallel run of two_level.py against a single-threaded one
+
+This script is run with python3, not with gem5. It runs two_level.py
+twice with the same system, the memory controller behind a
+MailboxBridge: once with a single event queue, and once spread over
+--event_queues queues by the partitioner. The stats of both runs are
+compared, and every stat that differs by more than the tolerance is
+reported. The host time of both runs is printed as well.
+
+This checks that the MailboxBridge and the partitioner keep the results
+of a run, not that the run is faster. Only the memory controller moves
+to another queue, so the host time mostly shows the cost of the
+synchronisation. The cores of a coherent system cannot be split, see
+eventq_partition.py.
+
+The delivery ticks of the MailboxBridge do not depend on the number of
+queues, so the runs should only differ by the order of events that
+happen on the same tick.
+
+Example:
+
+    python3 configs/learning_gem5/DBI/BaseDBI/validate_parallel.py \\
+        build/X86/gem5.opt configs/learning_gem5/DBI/BaseDBI/add \\
+        --event_queues 2 --dbi -n 100000
+
+The script exits with status 1 if a run fails or a stat differs.
+"""
+
+import argparse
+import os
+import subprocess
+import sys
+
+thispath = os.path.dirname(os.path.realpath(__file__))
+
+def parse_stats(path):
+    """Read the stats of the last dump of a stats.txt file"""
+    stats = {}
+    with open(path) as f:
+        for line in f:
+            if line.startswith('---------- Begin Simulation Statistics'):
+                stats = {}
+                continue
+            fields = line.split()
+            if len(fields) < 2 or fields[0].startswith('#'):
+                continue
+            stats[fields[0]] = fields[1]
+    return stats
+
+def is_host_stat(name):
+    """Check if a stat measures the host rather than the simulation"""
+    return name.startswith('host')
+
+def run(args, event_queues):
+    """Run two_level.py with a number of event queues"""
+    outdir = os.path.join(args.outdir, 'eventq-%d' % event_queues)
+    os.makedirs(outdir, exist_ok=True)
+    cmd = [args.gem5, '--outdir=%s' % outdir,
+           os.path.join(thispath, 'two_level.py'), args.binary,
+           '-n', args.nums, '-t', args.iterations,
+           '--event_queues=%d' % event_queues,
+           '--sim_quantum=%d' % args.sim_quantum,
+           '--mailbox_delay=%s' % args.mailbox_delay]
+    if args.dbi:
+        cmd.append('--dbi')
+
+    print("Running %s" % ' '.join(cmd))
+    with open(os.path.join(outdir, 'gem5.log'), 'w') as log:
+        status = subprocess.call(cmd, stdout=log, stderr=subprocess.STDOUT)
+    if status != 0:
+        print("Run with %d event queues failed with status %d, see %s" %
+              (event_queues, status, os.path.join(outdir, 'gem5.log')))
+        return None
+    return parse_stats(os.path.join(outdir, 'stats.txt'))
+
+def differs(reference, value, tolerance):
+    """Compare two stat values, numerically if they are numbers"""
+    try:
+        reference, value = float(reference), float(value)
+    except ValueError:
+        return reference != value
+    return abs(value - reference) > tolerance * max(abs(reference), 1e-12)
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Compare a parallel run of two_level.py to a '
+                    'single-threaded one.')
+    parser.add_argument('gem5', help="Path to the gem5 binary.")
+    parser.add_argument('binary', help="Path to the binary to simulate.")
+    parser.add_argument('--event_queues', type=int, default=2,
+                        help="Number of event queues of the parallel run. "
+                             "Default: 2")
+    parser.add_argument('--sim_quantum', type=int, default=10000,
+                        help="Simulation quantum in ticks. Default: 10000")
+    parser.add_argument('--mailbox_delay', default='20ns',
+                        help="Delay of the MailboxBridge. Default: 20ns")
+    parser.add_argument('--dbi', action='store_true',
+                        help="Use an L2 cache with a DBI")
+    parser.add_argument('-n', '--nums', default='2',
+                        help="Number of elements in each array. Default: 2")
+    parser.add_argument('-t', '--iterations', default='1',
+                        help="Number of iterations. Default: 1")
+    parser.add_argument('--tolerance', type=float, default=0.0,
+                        help="Relative difference allowed for a stat. "
+                             "Default: 0")
+    parser.add_argument('--outdir', default='validate_parallel',
+                        help="Directory of the run outputs. "
+                             "Default: validate_parallel")
+    args = parser.parse_args()
+
+    if args.event_queues < 2:
+        parser.error("The parallel run needs at least 2 event queues")
+
+    reference = run(args, 1)
+    parallel = run(args, args.event_queues)
+    if reference is None or parallel is None:
+        return 1
+
+    mismatches = []
+    for name in sorted(set(reference) | set(parallel)):
+        if is_host_stat(name):
+            continue
+        if name not in reference or name not in parallel:
+            mismatches.append((name, reference.get(name, '(missing)'),
+                               parallel.get(name, '(missing)')))
+        elif differs(reference[name], parallel[name], args.tolerance):
+            mismatches.append((name, reference[name], parallel[name]))
+
+    for name, ref_value, value in mismatches:
+        print("%s: %s with 1 event queue, %s with %d" %
+              (name, ref_value, value, args.event_queues))
+
+    if 'hostSeconds' in reference and 'hostSeconds' in parallel:
+        print("hostSeconds: %s with 1 event queue, %s with %d" %
+              (reference['hostSeconds'], parallel['hostSeconds'],
+               args.event_queues))
+
+    if mismatches:
+        print("%d stats differ" % len(mismatches))
+        return 1
+    print("All stats match")
+    return 0
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -42,6 +42,7 @@
 #include "base/random.hh"
 #include "config/have_protobuf.hh"
 #include "cpu/testers/traffic_gen/base_gen.hh"
+#include "cpu/testers/traffic_gen/dbi_gen.hh"
 #include "cpu/testers/traffic_gen/dram_gen.hh"
 #include "cpu/testers/traffic_gen/dram_rot_gen.hh"
 #include "cpu/testers/traffic_gen/exit_gen.hh"
@@ -542,6 +543,24 @@ BaseTrafficGen::createStrided(Tick duration,
                                                   read_percent, data_limit));
 }
 
+std::shared_ptr<BaseGen>
+BaseTrafficGen::createDBI(Tick duration,
+                          Addr start_addr, Addr end_addr, Addr blocksize,
+                          Addr region_size, uint8_t dirty_density,
+                          unsigned int reuse_distance, uint8_t reuse_percent,
+                          Tick min_period, Tick max_period,
+                          uint8_t read_percent, Addr data_limit)
+{
+    return std::shared_ptr<BaseGen>(new DBIGen(*this, requestorId,
+                                               duration, start_addr,
+                                               end_addr, blocksize,
+                                               system->cacheLineSize(),
+                                               region_size, dirty_density,
+                                               reuse_distance, reuse_percent,
+                                               min_period, max_period,
+                                               read_percent, data_limit));
+}
+
 std::shared_ptr<BaseGen>
 BaseTrafficGen::createTrace(Tick duration,
                             const std::string& trace_file, Addr addr_offset)
@@ -325,6 +325,14 @@ class BaseTrafficGen : public ClockedObject
         Tick min_period, Tick max_period,
         uint8_t read_percent, Addr data_limit);
 
+    std::shared_ptr<BaseGen> createDBI(
+        Tick duration,
+        Addr start_addr, Addr end_addr, Addr blocksize,
+        Addr region_size, uint8_t dirty_density,
+        unsigned int reuse_distance, uint8_t reuse_percent,
+        Tick min_period, Tick max_period,
+        uint8_t read_percent, Addr data_limit);
+
     std::shared_ptr<BaseGen> createTrace(
         Tick duration,
         const std::string& trace_file, Addr addr_offset);
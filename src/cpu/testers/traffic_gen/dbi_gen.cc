@@ -0,0 +1,146 @@
+#include "cpu/testers/traffic_gen/dbi_gen.hh"
+
+#include <algorithm>
+
+#include "base/logging.hh"
+#include "base/random.hh"
+#include "base/trace.hh"
+#include "debug/TrafficGen.hh"
+
+namespace gem5
+{
+
+DBIGen::DBIGen(SimObject &obj,
+               RequestorID requestor_id, Tick _duration,
+               Addr start_addr, Addr end_addr,
+               Addr _blocksize, Addr cacheline_size,
+               Addr region_size, uint8_t dirty_density,
+               unsigned int reuse_distance, uint8_t reuse_percent,
+               Tick min_period, Tick max_period,
+               uint8_t read_percent, Addr data_limit)
+    : StochasticGen(obj, requestor_id, _duration, start_addr, end_addr,
+                    _blocksize, cacheline_size, min_period, max_period,
+                    read_percent, data_limit),
+      regionSize(region_size),
+      blocksPerRegion(region_size / _blocksize),
+      writesPerVisit(std::max(1u, divCeil(blocksPerRegion * dirty_density,
+                                          100u))),
+      reusePercent(reuse_percent),
+      numRegions((end_addr - start_addr) / region_size),
+      ring(reuse_distance + 1),
+      ringPos(0), nextBlock(0), writesDone(0),
+      dataManipulated(0)
+{
+    if (region_size < _blocksize || region_size % _blocksize != 0)
+        fatal("%s: region size %d must be a multiple of the block size %d\n",
+              name(), region_size, _blocksize);
+    if (dirty_density == 0 || dirty_density > 100)
+        fatal("%s: dirty density %d must be in [1, 100]\n",
+              name(), dirty_density);
+    if (reuse_percent > 100)
+        fatal("%s: reuse percent %d must be in [0, 100]\n",
+              name(), reuse_percent);
+    if (read_percent == 100)
+        fatal("%s: the DBI generator needs writes, read percent must be "
+              "below 100\n", name());
+    if (numRegions == 0)
+        fatal("%s: the address range holds no region of %d bytes\n",
+              name(), region_size);
+}
+
+Addr
+DBIGen::randomRegion() const
+{
+    return startAddr + random_mt.random<Addr>(0, numRegions - 1) * regionSize;
+}
+
+void
+DBIGen::enter()
+{
+    // reset the data counter and fill the ring with random regions
+    dataManipulated = 0;
+    for (auto &region : ring)
+        region = randomRegion();
+
+    // start the visit of the first region
+    ringPos = ring.size() - 1;
+    writesDone = 0;
+    nextRegion();
+}
+
+void
+DBIGen::nextRegion()
+{
+    // the region just visited may leave the ring, on entering the state
+    // no region has been visited yet
+    if (writesDone && random_mt.random(0, 99) >= reusePercent)
+        ring[ringPos] = randomRegion();
+
+    ringPos = (ringPos + 1) % ring.size();
+    nextBlock = random_mt.random(0u, blocksPerRegion - 1);
+    writesDone = 0;
+
+    DPRINTF(TrafficGen, "DBIGen::nextRegion: region %x, first block %d\n",
+            ring[ringPos], nextBlock);
+}
+
+PacketPtr
+DBIGen::getNextPacket()
+{
+    // choose if we generate a read or a write here
+    bool isRead = readPercent != 0 &&
+        random_mt.random(0, 100) < readPercent;
+
+    // reads go to any block of the region, writes to the next block
+    // of the run
+    unsigned int block = isRead ?
+        random_mt.random(0u, blocksPerRegion - 1) : nextBlock;
+    Addr addr = ring[ringPos] + block * blocksize;
+
+    DPRINTF(TrafficGen, "DBIGen::getNextPacket: %c to addr %x, size %d\n",
+            isRead ? 'r' : 'w', addr, blocksize);
+
+    // Add the amount of data manipulated to the total
+    dataManipulated += blocksize;
+
+    PacketPtr pkt = getPacket(addr, blocksize,
+                              isRead ? MemCmd::ReadReq : MemCmd::WriteReq);
+
+    if (!isRead) {
+        nextBlock = (nextBlock + 1) % blocksPerRegion;
+        if (++writesDone == writesPerVisit)
+            nextRegion();
+    }
+
+    return pkt;
+}
+
+Tick
+DBIGen::nextPacketTick(bool elastic, Tick delay) const
+{
+    // Check to see if we have reached the data limit. If dataLimit is
+    // zero we do not have a data limit and therefore we will keep
+    // generating requests for the entire residency in this state.
+    if (dataLimit && dataManipulated >= dataLimit) {
+        DPRINTF(TrafficGen, "Data limit for DBIGen reached.\n");
+        // there are no more requests, therefore return MaxTick
+        return MaxTick;
+    } else {
+        // return the time when the next request should take place
+        Tick wait = random_mt.random(minPeriod, maxPeriod);
+
+        // compensate for the delay experienced to not be elastic, by
+        // default the value we generate is from the time we are
+        // asked, so the elasticity happens automatically
+        if (!elastic) {
+            if (wait < delay)
+                wait = 0;
+            else
+                wait -= delay;
+        }
+
+        return curTick() + wait;
+    }
+}
+
+} // namespace gem5
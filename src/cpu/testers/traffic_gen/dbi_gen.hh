@@ -0,0 +1,127 @@
+/**
+ * @file
+ * Declaration of the DBI generator that generates region-clustered
+ * write streams, to characterise a dirty-block index without a CPU
+ * model.
+ */
+
+#ifndef __CPU_TRAFFIC_GEN_DBI_GEN_HH__
+#define __CPU_TRAFFIC_GEN_DBI_GEN_HH__
+
+#include <vector>
+
+#include "base/bitfield.hh"
+#include "base/intmath.hh"
+#include "base_gen.hh"
+#include "mem/packet.hh"
+
+namespace gem5
+{
+
+/**
+ * The DBI generator writes to the address range one region at a
+ * time. A region is an aligned block of region_size bytes, i.e. the
+ * memory tracked by one DBI entry. On each visit of a region, the
+ * generator writes dirty_density percent of its blocks, as a
+ * contiguous run starting at a random block, and then moves on to the
+ * next region.
+ *
+ * The visited regions form a ring of reuse_distance + 1 regions, so a
+ * region is visited again after reuse_distance other regions. On each
+ * visit, a region is kept in the ring with a probability of
+ * reuse_percent, otherwise it is replaced by a random region of the
+ * range. A reuse percent of zero gives a stream of fresh regions.
+ *
+ * A fraction of the requests are reads, as determined by the read
+ * percent. A read goes to a random block of the current region, and
+ * does not count towards the writes of the visit. There is an
+ * optional data limit for when to stop generating new requests.
+ */
+class DBIGen : public StochasticGen
+{
+
+  public:
+
+    /**
+     * Create a DBI sequence generator. Set min_period == max_period
+     * for a fixed inter-transaction time.
+     *
+     * @param obj SimObject owning this sequence generator
+     * @param requestor_id RequestorID related to the memory requests
+     * @param _duration duration of this state before transitioning
+     * @param start_addr Start address
+     * @param end_addr End address
+     * @param _blocksize Size used for transactions injected
+     * @param cacheline_size cache line size in the system
+     * @param region_size Size of a region, a multiple of the blocksize
+     * @param dirty_density Percent of the blocks of a region written
+     *                      on each visit
+     * @param reuse_distance Number of other regions visited between
+     *                       two visits of a region
+     * @param reuse_percent Percent of visits after which the region
+     *                      stays in the ring
+     * @param min_period Lower limit of random inter-transaction time
+     * @param max_period Upper limit of random inter-transaction time
+     * @param read_percent Percent of transactions that are reads
+     * @param data_limit Upper limit on how much data to read/write
+     */
+    DBIGen(SimObject &obj,
+           RequestorID requestor_id, Tick _duration,
+           Addr start_addr, Addr end_addr,
+           Addr _blocksize, Addr cacheline_size,
+           Addr region_size, uint8_t dirty_density,
+           unsigned int reuse_distance, uint8_t reuse_percent,
+           Tick min_period, Tick max_period,
+           uint8_t read_percent, Addr data_limit);
+
+    void enter();
+
+    PacketPtr getNextPacket();
+
+    Tick nextPacketTick(bool elastic, Tick delay) const;
+
+  private:
+    /** Pick a random region of the address range */
+    Addr randomRegion() const;
+
+    /** Move on to the next region of the ring and start its visit */
+    void nextRegion();
+
+    /** Size of a region */
+    const Addr regionSize;
+
+    /** Number of blocks in a region */
+    const unsigned int blocksPerRegion;
+
+    /** Number of blocks written on each visit of a region */
+    const unsigned int writesPerVisit;
+
+    /** Percent of visits after which the region stays in the ring */
+    const uint8_t reusePercent;
+
+    /** Number of regions in the address range */
+    const Addr numRegions;
+
+    /** Start addresses of the regions of the ring */
+    std::vector<Addr> ring;
+
+    /** Position of the current region in the ring */
+    unsigned int ringPos;
+
+    /** Block of the current region written next */
+    unsigned int nextBlock;
+
+    /** Number of blocks written in the current visit */
+    unsigned int writesDone;
+
+    /**
+     * Counter to determine the amount of data
+     * manipulated. Used to determine if we should continue
+     * generating requests.
+     */
+    Addr dataManipulated;
+};
+
+} // namespace gem5
+
+#endif
@@ -44,7 +44,7 @@ from m5.objects.QoSMemCtrl import *
 
 # Enum for memory scheduling algorithms, currently First-Come
 # First-Served and a First-Row Hit then First-Come First-Served
-class MemSched(Enum): vals = ['fcfs', 'frfcfs']
+class MemSched(Enum): vals = ['fcfs', 'frfcfs', 'frfcfs_rowbatch']
 
 # MemCtrl is a single-channel single-ported Memory controller model
 # that aims to model the most important system-level performance
@@ -82,7 +82,16 @@ class MemCtrl(QoSMemCtrl):
     min_reads_per_switch = Param.Unsigned(16, "Minimum read bursts before "
                                            "switching to writes")
 
+    # keep writes that are tagged as a row batch (e.g. the writebacks of
+    # a DBI region flush) together, and finish the batch in its open row
+    # before switching back to reads
+    row_batch_drain = Param.Bool(True, "Drain row-batched writes "
+                                 "back-to-back before switching to reads")
+
     # scheduler, address map and page policy
+    # frfcfs_rowbatch treats every write as part of a row batch: once a
+    # write to a row issues, the queued writes to the same bank and row
+    # are drained before any other write or a switch to reads
     mem_sched_policy = Param.MemSched('frfcfs', "Memory scheduling policy")
 
     # pipeline latency of the controller and PHY, split into a
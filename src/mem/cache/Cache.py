@@ -176,6 +176,52 @@ class DBICache(Cache):
     dbi_assoc = Param.Unsigned("Associativity of the DBI")
     blk_per_dbi_entry = Param.Unsigned("Number of cache blocks per DBI entry")
     aggr_writeback = Param.Bool("Use aggressive writeback mechanism")
+    # The tag store already uses replacement_policy, so the RDBI has its own
+    dbi_replacement_policy = Param.BaseReplacementPolicy(LRURP(),
+        "Replacement policy of the RDBI entries")
+    # Optional indexing policy of the RDBI, e.g. RDBISkewedAssociative(). If
+    # not set, the RDBI set is given by the low bits of the region tag
+    dbi_indexing_policy = Param.BaseIndexingPolicy(NULL,
+        "Indexing policy of the RDBI entries")
+    # Cache lookup bypass: reads predicted to miss on a clean block take the
+    # DBI lookup latency instead of the tag lookup latency. This only models
+    # the latency, the tags are still accessed
+    clb_enable = Param.Bool(False, "Use the DBI-based cache lookup bypass")
+    clb_dbi_latency = Param.Cycles(1,
+        "Latency of the DBI lookup that checks a bypassed read is clean")
+    clb_table_size = Param.Unsigned(1024,
+        "Number of counters of the cache lookup bypass miss predictor")
+    clb_counter_bits = Param.Unsigned(2,
+        "Number of bits of the miss predictor counters")
+    # Heterogeneous ECC: only the dirty blocks tracked by the DBI keep a
+    # strong ECC, clean blocks keep an error detecting code
+    ecc_enable = Param.Bool(False, "Model the heterogeneous ECC of the DBI")
+    ecc_bits_per_blk = Param.Unsigned(64,
+        "Check bits of the ECC of a dirty block (SECDED per 64-bit word)")
+    edc_bits_per_blk = Param.Unsigned(8,
+        "Check bits of the error detecting code of a block (parity)")
+    ecc_check_latency = Param.Cycles(2,
+        "Latency of the ECC check on a read of a dirty block")
+    edc_check_latency = Param.Cycles(0,
+        "Latency of the error detection on a read of a clean block")
+    ecc_check_energy = Param.Float(10.0,
+        "Energy of an ECC check, in pJ")
+    edc_check_energy = Param.Float(1.0,
+        "Energy of an error detection check, in pJ")
+    # Idle-time writeback: while nothing is queued towards memory, the least
+    # recently written region is cleaned, so that later evictions are clean.
+    # Only the MSHRs and the write buffer of this cache are checked, the
+    # traffic of the other requestors of the memory side is not seen
+    idle_writeback_enable = Param.Bool(False,
+        "Clean RDBI regions while the memory side is idle")
+    idle_writeback_period = Param.Cycles(1000,
+        "Minimum number of cycles between two regions cleaned at idle time")
+    # Shared DBI: the slices of a banked cache use one RDBI, so that region
+    # writebacks gather the blocks of a region held by every slice. blkSize
+    # and blk_per_dbi_entry must match the SharedDBI, the other DBI
+    # parameters of the slice then only size its ECC
+    shared_dbi = Param.SharedDBI(NULL,
+        "DBI shared with the other slices of the cache")
       
     # Parameters to DBI from the parent class
     size = Param.MemorySize("DBI cache size") 
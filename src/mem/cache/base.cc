@@ -57,6 +57,7 @@
 #include "mem/cache/mshr.hh"
 #include "mem/cache/prefetch/base.hh"
 #include "mem/cache/queue_entry.hh"
+#include "mem/cache/replacement_policies/clean_first_rp.hh"
 #include "mem/cache/tags/compressed_tags.hh"
 #include "mem/cache/tags/super_blk.hh"
 #include "params/BaseCache.hh"
@@ -127,6 +128,16 @@ BaseCache::BaseCache(const BaseCacheParams &p, unsigned blk_size)
     if (prefetcher)
         prefetcher->setCache(this);
 
+    // A clean-first replacement policy asks the cache for the dirty state
+    // of the candidates, as it is not necessarily kept in the blocks
+    if (auto rp = dynamic_cast<replacement_policy::CleanFirst*>(
+            p.replacement_policy)) {
+        rp->setDirtyQuery([this](const ReplaceableEntry *entry) {
+            const CacheBlk *blk = dynamic_cast<const CacheBlk*>(entry);
+            return blk && blk->isValid() && isBlkDirty(blk);
+        });
+    }
+
     fatal_if(compressor && !dynamic_cast<CompressedTags*>(tags),
         "The tags of compressed cache %s must derive from CompressedTags",
         name());
@@ -179,7 +190,7 @@ BaseCache::CacheResponsePort::processSendRetry()
 }
 
 Addr
-BaseCache::regenerateBlkAddr(CacheBlk* blk)
+BaseCache::regenerateBlkAddr(const CacheBlk* blk) const
 {
     if (blk != tempBlock) {
         return tags->regenerateBlkAddr(blk);
@@ -245,7 +256,7 @@ BaseCache::handleTimingReqHit(PacketPtr pkt, CacheBlk *blk, Tick request_time)
             // Basically we need to get the MSHR in the same state as if
             // we had missed and just received the response.
             // Request *req2 = new Request(*(pkt->req));
-            RequestPtr req2 = std::make_shared<Request>(*(pkt->req));
+            RequestPtr req2 = Request::create(*(pkt->req));
             PacketPtr pkt2 = new Packet(req2, pkt->cmd);
             MSHR *mshr = allocateMissBuffer(pkt2, curTick(), true);
             // Mark the MSHR "in service" (even though it's not) to prevent
@@ -645,7 +656,7 @@ BaseCache::recvAtomic(PacketPtr pkt)
     PacketList writebacks;
     bool satisfied = access(pkt, blk, lat, writebacks);
 
-    if (pkt->isClean() && blk && blk->isSet(CacheBlk::DirtyBit)) {
+    if (pkt->isClean() && blk && isBlkDirty(blk)) {
         // A cache clean opearation is looking for a dirty
         // block. If a dirty block is encountered a WriteClean
         // will update any copies to the path to the memory
@@ -735,7 +746,7 @@ BaseCache::functionalAccess(PacketPtr pkt, bool from_cpu_side)
     // data we have is dirty if marked as such or if we have an
     // in-service MSHR that is pending a modified line
     bool have_dirty =
-        have_data && (blk->isSet(CacheBlk::DirtyBit) ||
+        have_data && (isBlkDirty(blk) ||
                       (mshr && mshr->inService && mshr->isPendingModified()));
 
     bool done = have_dirty ||
@@ -835,7 +846,7 @@ BaseCache::cmpAndSwap(CacheBlk *blk, PacketPtr pkt)
 
     if (overwrite_mem) {
         std::memcpy(blk_data, &overwrite_val, pkt->getSize());
-        blk->setCoherenceBits(CacheBlk::DirtyBit);
+        setBlkDirty(blk, pkt);
 
         if (ppDataUpdate->hasListeners()) {
             data_update.newData = std::vector<uint64_t>(blk->data,
@@ -1065,7 +1076,12 @@ BaseCache::updateCompressionData(CacheBlk *&blk, const uint64_t* data,
         if (!victim_itself && (replaceExpansions || is_data_contraction)) {
             // Move the block's contents to the invalid block so that it now
             // co-allocates with the other existing superblock entry
+            const bool is_dirty = isBlkDirty(blk);
             tags->moveBlock(blk, victim);
+            // Dirty state kept outside of the block must follow the move
+            if (is_dirty) {
+                setBlkDirty(victim, nullptr);
+            }
             blk = victim;
             compression_blk = static_cast<CompressionBlk*>(blk);
         }
@@ -1128,7 +1144,7 @@ BaseCache::satisfyRequest(PacketPtr pkt, CacheBlk *blk, bool, bool)
             }
 
             // set block status to dirty
-            blk->setCoherenceBits(CacheBlk::DirtyBit);
+            setBlkDirty(blk, pkt);
         } else {
             cmpAndSwap(blk, pkt);
         }
@@ -1146,7 +1162,7 @@ BaseCache::satisfyRequest(PacketPtr pkt, CacheBlk *blk, bool, bool)
         // Modified state) even if we are a failed StoreCond so we
         // supply data to any snoops that have appended themselves to
         // this cache before knowing the store will fail.
-        blk->setCoherenceBits(CacheBlk::DirtyBit);
+        setBlkDirty(blk, pkt);
         DPRINTF(CacheVerbose, "%s for %s (write)\n", __func__, pkt->print());
     } else if (pkt->isRead()) {
         if (pkt->isLLSC()) {
@@ -1160,15 +1176,15 @@ BaseCache::satisfyRequest(PacketPtr pkt, CacheBlk *blk, bool, bool)
         // sanity check
         assert(!pkt->hasSharers());
 
-        if (blk->isSet(CacheBlk::DirtyBit)) {
+        if (isBlkDirty(blk)) {
             // we were in the Owned state, and a cache above us that
             // has the line in Shared state needs to be made aware
             // that the data it already has is in fact dirty
             pkt->setCacheResponding();
-            blk->clearCoherenceBits(CacheBlk::DirtyBit);
+            clearBlkDirty(blk);
         }
     } else if (pkt->isClean()) {
-        blk->clearCoherenceBits(CacheBlk::DirtyBit);
+        clearBlkDirty(blk);
     } else {
         assert(pkt->isInvalidate());
         invalidateBlock(blk);
@@ -1356,7 +1372,7 @@ BaseCache::access(PacketPtr pkt, CacheBlk *&blk, Cycles &lat,
         // and leave it as is for a clean writeback
         if (pkt->cmd == MemCmd::WritebackDirty) {
             // TODO: the coherent cache can assert that the dirty bit is set
-            blk->setCoherenceBits(CacheBlk::DirtyBit);
+            setBlkDirty(blk, pkt);
         }
         // if the packet does not have sharers, it is passing
         // writable, and we got the writeback in Modified or Exclusive
@@ -1437,7 +1453,7 @@ BaseCache::access(PacketPtr pkt, CacheBlk *&blk, Cycles &lat,
         assert(blk);
         // TODO: the coherent cache can assert that the dirty bit is set
         if (!pkt->writeThrough()) {
-            blk->setCoherenceBits(CacheBlk::DirtyBit);
+            setBlkDirty(blk, pkt);
         }
         // nothing else to do; writeback doesn't expect response
         assert(!pkt->needsResponse());
@@ -1500,7 +1516,7 @@ void
 BaseCache::maintainClusivity(bool from_cache, CacheBlk *blk)
 {
     if (from_cache && blk && blk->isValid() &&
-        !blk->isSet(CacheBlk::DirtyBit) && clusivity == enums::mostly_excl) {
+        !isBlkDirty(blk) && clusivity == enums::mostly_excl) {
         // if we have responded to a cache, and our block is still
         // valid, but not dirty, and this cache is mostly exclusive
         // with respect to the cache above, drop the block
@@ -1577,7 +1593,7 @@ BaseCache::handleFill(PacketPtr pkt, CacheBlk *blk, PacketList &writebacks,
         if (pkt->cacheResponding()) {
             // we got the block in Modified state, and invalidated the
             // owners copy
-            blk->setCoherenceBits(CacheBlk::DirtyBit);
+            setBlkDirty(blk, pkt);
 
             gem5_assert(!isReadOnly, "Should never see dirty snoop response "
                         "in read-only cache %s\n", name());
@@ -1643,11 +1659,26 @@ BaseCache::allocateBlock(const PacketPtr pkt, PacketList &writebacks)
     // Print victim block's information
     DPRINTF(CacheRepl, "Replacement victim: %s\n", victim->print());
 
+    // Dirty blocks evicted by a prefetch fill cause write traffic, count
+    // them before the eviction cleans them
+    unsigned pf_dirty_evictions = 0;
+    if (prefetcher && pkt->cmd == MemCmd::HardPFResp) {
+        for (const auto& blk : evict_blks) {
+            if (blk->isValid() && isBlkDirty(blk)) {
+                pf_dirty_evictions++;
+            }
+        }
+    }
+
     // Try to evict blocks; if it fails, give up on allocation
     if (!handleEvictions(evict_blks, writebacks)) {
         return nullptr;
     }
 
+    for (unsigned i = 0; i < pf_dirty_evictions; i++) {
+        prefetcher->pfDirtyEviction();
+    }
+
     // Insert new block at victimized entry
     tags->insertBlock(pkt, victim);
 
@@ -1661,6 +1692,26 @@ BaseCache::allocateBlock(const PacketPtr pkt, PacketList &writebacks)
     return victim;
 }
 
+bool
+BaseCache::fillEvictsDirty(Addr addr, bool is_secure) const
+{
+    // A block already in the cache is not allocated again
+    if (tags->findBlock(addr, is_secure)) {
+        return false;
+    }
+
+    // Peek at the victim, as findVictim() would update the replacement
+    // state and the statistics of a fill that may not happen
+    std::vector<CacheBlk*> evict_blks;
+    tags->peekVictim(addr, is_secure, blkSize*8, evict_blks);
+    for (const auto& blk : evict_blks) {
+        if (blk->isValid() && isBlkDirty(blk)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 void
 BaseCache::invalidateBlock(CacheBlk *blk)
 {
@@ -1672,6 +1723,11 @@ BaseCache::invalidateBlock(CacheBlk *blk)
     // Notify that the data contents for this address are no longer present
     updateBlockData(blk, nullptr, blk->isValid());
 
+    // Drop any dirty state kept outside of the block
+    if (blk->isValid()) {
+        clearBlkDirty(blk);
+    }
+
     // If handling a block present in the Tags, let it do its invalidation
     // process, which will update stats and invalidate the block itself
     if (blk != tempBlock) {
@@ -1681,6 +1737,24 @@ BaseCache::invalidateBlock(CacheBlk *blk)
     }
 }
 
+bool
+BaseCache::isBlkDirty(const CacheBlk *blk) const
+{
+    return blk->isSet(CacheBlk::DirtyBit);
+}
+
+void
+BaseCache::setBlkDirty(CacheBlk *blk, const PacketPtr pkt)
+{
+    blk->setCoherenceBits(CacheBlk::DirtyBit);
+}
+
+void
+BaseCache::clearBlkDirty(CacheBlk *blk)
+{
+    blk->clearCoherenceBits(CacheBlk::DirtyBit);
+}
+
 void
 BaseCache::evictBlock(CacheBlk *blk, PacketList &writebacks)
 {
@@ -1696,11 +1770,11 @@ BaseCache::writebackBlk(CacheBlk *blk)
     gem5_assert(!isReadOnly || writebackClean,
                 "Writeback from read-only cache");
     assert(blk && blk->isValid() &&
-        (blk->isSet(CacheBlk::DirtyBit) || writebackClean));
+        (isBlkDirty(blk) || writebackClean));
 
     stats.writebacks[Request::wbRequestorId]++;
 
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
         regenerateBlkAddr(blk), blkSize, 0, Request::wbRequestorId);
 
     if (blk->isSecure())
@@ -1709,12 +1783,12 @@ BaseCache::writebackBlk(CacheBlk *blk)
     req->taskId(blk->getTaskId());
 
     PacketPtr pkt =
-        new Packet(req, blk->isSet(CacheBlk::DirtyBit) ?
+        new Packet(req, isBlkDirty(blk) ?
                    MemCmd::WritebackDirty : MemCmd::WritebackClean);
 
     DPRINTF(Cache, "Create Writeback %s writable: %d, dirty: %d\n",
         pkt->print(), blk->isSet(CacheBlk::WritableBit),
-        blk->isSet(CacheBlk::DirtyBit));
+        isBlkDirty(blk));
 
     if (blk->isSet(CacheBlk::WritableBit)) {
         // not asserting shared means we pass the block in modified
@@ -1726,7 +1800,7 @@ BaseCache::writebackBlk(CacheBlk *blk)
     }
 
     // make sure the block is not marked dirty
-    blk->clearCoherenceBits(CacheBlk::DirtyBit);
+    clearBlkDirty(blk);
 
     pkt->allocate();
     pkt->setDataFromBlock(blk->data, blkSize);
@@ -1743,7 +1817,7 @@ BaseCache::writebackBlk(CacheBlk *blk)
 PacketPtr
 BaseCache::writecleanBlk(CacheBlk *blk, Request::Flags dest, PacketId id)
 {
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
         regenerateBlkAddr(blk), blkSize, 0, Request::wbRequestorId);
 
     if (blk->isSecure()) {
@@ -1759,7 +1833,7 @@ BaseCache::writecleanBlk(CacheBlk *blk, Request::Flags dest, PacketId id)
     }
 
     DPRINTF(Cache, "Create %s writable: %d, dirty: %d\n", pkt->print(),
-            blk->isSet(CacheBlk::WritableBit), blk->isSet(CacheBlk::DirtyBit));
+            blk->isSet(CacheBlk::WritableBit), isBlkDirty(blk));
 
     if (blk->isSet(CacheBlk::WritableBit)) {
         // not asserting shared means we pass the block in modified
@@ -1771,7 +1845,7 @@ BaseCache::writecleanBlk(CacheBlk *blk, Request::Flags dest, PacketId id)
     }
 
     // make sure the block is not marked dirty
-    blk->clearCoherenceBits(CacheBlk::DirtyBit);
+    clearBlkDirty(blk);
 
     pkt->allocate();
     pkt->setDataFromBlock(blk->data, blkSize);
@@ -1801,8 +1875,8 @@ BaseCache::memInvalidate()
 bool
 BaseCache::isDirty() const
 {
-    return tags->anyBlk([](CacheBlk &blk) {
-        return blk.isSet(CacheBlk::DirtyBit); });
+    return tags->anyBlk([this](CacheBlk &blk) {
+        return isBlkDirty(&blk); });
 }
 
 bool
@@ -1814,10 +1888,10 @@ BaseCache::coalesce() const
 void
 BaseCache::writebackVisitor(CacheBlk &blk)
 {
-    if (blk.isSet(CacheBlk::DirtyBit)) {
+    if (isBlkDirty(&blk)) {
         assert(blk.isValid());
 
-        RequestPtr request = std::make_shared<Request>(
+        RequestPtr request = Request::create(
             regenerateBlkAddr(&blk), blkSize, 0, Request::funcRequestorId);
 
         request->taskId(blk.getTaskId());
@@ -1830,19 +1904,19 @@ BaseCache::writebackVisitor(CacheBlk &blk)
 
         memSidePort.sendFunctional(&packet);
 
-        blk.clearCoherenceBits(CacheBlk::DirtyBit);
+        clearBlkDirty(&blk);
     }
 }
 
 void
 BaseCache::invalidateVisitor(CacheBlk &blk)
 {
-    if (blk.isSet(CacheBlk::DirtyBit))
+    if (isBlkDirty(&blk))
         warn_once("Invalidating dirty cache lines. " \
                   "Expect things to break.\n");
 
     if (blk.isValid()) {
-        assert(!blk.isSet(CacheBlk::DirtyBit));
+        assert(!isBlkDirty(&blk));
         invalidateBlock(&blk);
     }
 }
@@ -1918,7 +1992,7 @@ BaseCache::sendMSHRQueuePacket(MSHR* mshr)
     // as forwarded packets may already have existing state
     pkt->pushSenderState(mshr);
 
-    if (pkt->isClean() && blk && blk->isSet(CacheBlk::DirtyBit)) {
+    if (pkt->isClean() && blk && isBlkDirty(blk)) {
         // A cache clean opearation is looking for a dirty block. Mark
         // the packet so that the destination xbar can determine that
         // there will be a follow-up write packet as well.
@@ -1949,7 +2023,7 @@ BaseCache::sendMSHRQueuePacket(MSHR* mshr)
             pkt->cacheResponding();
         markInService(mshr, pending_modified_resp);
 
-        if (pkt->isClean() && blk && blk->isSet(CacheBlk::DirtyBit)) {
+        if (pkt->isClean() && blk && isBlkDirty(blk)) {
             // A cache clean opearation is looking for a dirty
             // block. If a dirty block is encountered a WriteClean
             // will update any copies to the path to the memory
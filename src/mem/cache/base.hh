@@ -456,7 +456,7 @@ class BaseCache : public ClockedObject
      * @param blk The block to regenerate address.
      * @return The block's address.
      */
-    Addr regenerateBlkAddr(CacheBlk* blk);
+    Addr regenerateBlkAddr(const CacheBlk* blk) const;
 
     /**
      * Calculate latency of accesses that only touch the tag array.
@@ -827,6 +827,34 @@ class BaseCache : public ClockedObject
      */
     void invalidateBlock(CacheBlk *blk);
 
+    /**
+     * Check if a block holds data that has not been written back.
+     *
+     * By default the dirty state is the DirtyBit of the block. Caches
+     * that track it elsewhere, e.g. in a dirty-block index, override
+     * this function together with setBlkDirty() and clearBlkDirty().
+     *
+     * @param blk Valid block to check.
+     * @return Whether the block is dirty.
+     */
+    virtual bool isBlkDirty(const CacheBlk *blk) const;
+
+    /**
+     * Mark a block as dirty.
+     *
+     * @param blk Valid block to mark.
+     * @param pkt Packet that dirtied the block, can be nullptr.
+     */
+    virtual void setBlkDirty(CacheBlk *blk, const PacketPtr pkt);
+
+    /**
+     * Mark a block as clean, e.g. once its data has been written back
+     * or passed on to another cache, or before it is invalidated.
+     *
+     * @param blk Valid block to mark.
+     */
+    virtual void clearBlkDirty(CacheBlk *blk);
+
     /**
      * Create a writeback request for the given block.
      *
@@ -867,7 +895,7 @@ class BaseCache : public ClockedObject
      *
      * @return true if at least one block is dirty, false otherwise.
      */
-    bool isDirty() const;
+    virtual bool isDirty() const;
 
     /**
      * Determine if an address is in the ranges covered by this
@@ -1293,6 +1321,34 @@ class BaseCache : public ClockedObject
         return mshrQueue.findMatch(addr, is_secure);
     }
 
+    /**
+     * Check if allocating a block for an address would evict a dirty
+     * block. The victim is only peeked at, without updating the
+     * replacement state or the statistics, so the actual fill may pick
+     * another one if the set is accessed in between.
+     *
+     * @param addr The address of the block to allocate.
+     * @param is_secure True if the target memory space is secure.
+     * @return True if a dirty block would be evicted.
+     */
+    bool fillEvictsDirty(Addr addr, bool is_secure) const;
+
+    /**
+     * Number of dirty blocks of the DBI region holding an address. Only
+     * caches with a DBI track regions, the others have no dirty region.
+     *
+     * @param addr The address to look up.
+     * @return The number of dirty blocks of its region.
+     */
+    virtual unsigned dirtyBlksInRegion(Addr addr) const { return 0; }
+
+    /**
+     * Number of blocks of a DBI region.
+     *
+     * @return The number of blocks per region, 0 if there is no DBI.
+     */
+    virtual unsigned blksPerRegion() const { return 0; }
+
     void incMissCount(PacketPtr pkt)
     {
         assert(pkt->req->requestorId() < system->maxRequestors());
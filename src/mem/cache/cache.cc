@@ -97,10 +97,10 @@ namespace gem5
 
                     // if we have a dirty copy, make sure the recipient
                     // keeps it marked dirty (in the modified state)
-                    if (blk->isSet(CacheBlk::DirtyBit))
+                    if (isBlkDirty(blk))
                     {
                         pkt->setCacheResponding();
-                        blk->clearCoherenceBits(CacheBlk::DirtyBit);
+                        clearBlkDirty(blk);
                     }
                 }
                 else if (blk->isSet(CacheBlk::WritableBit) &&
@@ -117,7 +117,7 @@ namespace gem5
                     //   snooping the packet)
                     // - the read has explicitly asked for a clean
                     //   copy of the line
-                    if (blk->isSet(CacheBlk::DirtyBit))
+                    if (isBlkDirty(blk))
                     {
                         // special considerations if we're owner:
                         if (!deferred_response)
@@ -141,7 +141,7 @@ namespace gem5
                             // the cache hierarchy through a cache,
                             // and first snoop upwards in all other
                             // branches
-                            blk->clearCoherenceBits(CacheBlk::DirtyBit);
+                            clearBlkDirty(blk);
                         }
                         else
                         {
@@ -414,10 +414,10 @@ namespace gem5
             if (!mshr)
             {
                 // copy the request and create a new SoftPFReq packet
-                RequestPtr req = std::make_shared<Request>(pkt->req->getPaddr(),
-                                                           pkt->req->getSize(),
-                                                           pkt->req->getFlags(),
-                                                           pkt->req->requestorId());
+                RequestPtr req = Request::create(pkt->req->getPaddr(),
+                                                 pkt->req->getSize(),
+                                                 pkt->req->getFlags(),
+                                                 pkt->req->requestorId());
                 pf = new Packet(req, pkt->cmd);
                 pf->allocate();
                 assert(pf->matchAddr(pkt));
@@ -808,7 +808,7 @@ namespace gem5
                         // between the PrefetchExReq and the expected WriteReq, we
                         // proactively mark the block as Dirty.
                         assert(blk);
-                        blk->setCoherenceBits(CacheBlk::DirtyBit);
+                        setBlkDirty(blk, pkt);
 
                         panic_if(isReadOnly, "Prefetch exclusive requests from "
                                              "read-only cache %s\n",
@@ -1031,7 +1031,7 @@ namespace gem5
     PacketPtr
     Cache::evictBlock(CacheBlk *blk)
     {
-        PacketPtr pkt = (blk->isSet(CacheBlk::DirtyBit) || writebackClean) ? writebackBlk(blk) : cleanEvictBlk(blk);
+        PacketPtr pkt = (isBlkDirty(blk) || writebackClean) ? writebackBlk(blk) : cleanEvictBlk(blk);
 
         invalidateBlock(blk);
 
@@ -1042,10 +1042,10 @@ namespace gem5
     Cache::cleanEvictBlk(CacheBlk *blk)
     {
         assert(!writebackClean);
-        assert(blk && blk->isValid() && !blk->isSet(CacheBlk::DirtyBit));
+        assert(blk && blk->isValid() && !isBlkDirty(blk));
 
         // Creating a zero sized write, a message to the snoop filter
-        RequestPtr req = std::make_shared<Request>(
+        RequestPtr req = Request::create(
             regenerateBlkAddr(blk), blkSize, 0, Request::wbRequestorId);
 
         if (blk->isSecure())
@@ -1197,7 +1197,7 @@ namespace gem5
         bool blk_valid = blk && blk->isValid();
         if (pkt->isClean())
         {
-            if (blk_valid && blk->isSet(CacheBlk::DirtyBit))
+            if (blk_valid && isBlkDirty(blk))
             {
                 DPRINTF(CacheVerbose, "%s: packet (snoop) %s found block: %s\n",
                         __func__, pkt->print(), blk->print());
@@ -1252,9 +1252,9 @@ namespace gem5
             // invalidation itself is taken care of below. We don't respond to
             // cache maintenance operations as this is done by the destination
             // xbar.
-            respond = blk->isSet(CacheBlk::DirtyBit) && pkt->needsResponse();
+            respond = isBlkDirty(blk) && pkt->needsResponse();
 
-            gem5_assert(!(isReadOnly && blk->isSet(CacheBlk::DirtyBit)),
+            gem5_assert(!(isReadOnly && isBlkDirty(blk)),
                         "Should never have a dirty block in a read-only cache %s\n",
                         name());
         }
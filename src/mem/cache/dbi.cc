@@ -1,12 +1,17 @@
 
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 
 #include "mem/cache/rdbi/rdbi.hh"
+#include "mem/cache/rdbi/shared_dbi.hh"
 #include "mem/cache/dbi.hh"
 #include "base/compiler.hh"
+#include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "debug/DBICache.hh"
+#include "debug/Drain.hh"
 #include "enums/Clusivity.hh"
 #include "debug/CacheTags.hh"
 #include "debug/CacheVerbose.hh"
@@ -34,6 +39,17 @@ namespace gem5
           blkSize(p.blkSize),                       // Block Size
           numBlksInRegion(p.blk_per_dbi_entry),     // Number of blocks in a DBI entry
           useAggressiveWriteback(p.aggr_writeback), // Aggressive Writeback
+          clbEnabled(p.clb_enable),                 // Cache Lookup Bypass
+          clbDBILatency(p.clb_dbi_latency),
+          clbTable(p.clb_table_size, SatCounter8(p.clb_counter_bits)),
+          eccEnabled(p.ecc_enable),                 // Heterogeneous ECC
+          idleWritebackEnabled(p.idle_writeback_enable), // Idle-time writeback
+          idleWritebackPeriod(p.idle_writeback_period),
+          idleWritebackMaxBlks(p.write_buffers),
+          idleWritebackEvent([this]{ idleWriteback(); }, name() + ".idleWritebackEvent"),
+          dirtyClearCause(RDBIWriteback),
+          pendingWritebackEvent([this]{ sendPendingWritebacks(); }, name() + ".pendingWritebackEvent"),
+          sharedDBI(p.shared_dbi),                  // Shared DBI
           dbistats(*this, &stats)                   // DBI Cache Stats
 
     {
@@ -50,8 +66,415 @@ namespace gem5
         numBlockSizeBits = log2(blkSize);
         // Number of bits required to store the number of blocks in a region
         numBlockIndexBits = log2(numBlksInRegion);
-        // Call the constructor of the RDBI class
-        rdbi = new RDBI(numDBISets, numBlockSizeBits, numBlockIndexBits, dbiAssoc, numBlksInRegion, blkSize, useAggressiveWriteback, dbistats, *this);
+        // A region is tracked by a bitset sized at construction, up to 512 blocks
+        fatal_if(!isPowerOf2(numBlksInRegion) || numBlksInRegion > 512,
+                 "blk_per_dbi_entry of %s must be a power of two up to 512\n", name());
+        if (sharedDBI)
+        {
+            // The RDBI is shared with the other slices, the SharedDBI reports its stats
+            rdbi = sharedDBI->registerSlice(this, blkSize, numBlksInRegion);
+            dbistats.initDistributions(1, 1, 1);
+        }
+        else
+        {
+            // Call the constructor of the RDBI class
+            rdbi = new RDBI(numDBISets, numBlockSizeBits, numBlockIndexBits, dbiAssoc, numBlksInRegion, blkSize, useAggressiveWriteback, p.dbi_replacement_policy, p.dbi_indexing_policy, dbistats, name());
+        }
+        // Create the heterogeneous ECC model, its ECC storage is sized from the RDBI
+        ecc = new DBIECC(numBlksInCache, numDBIEntries * numBlksInRegion, p.ecc_bits_per_blk, p.edc_bits_per_blk, p.ecc_check_latency, p.edc_check_latency, p.ecc_check_energy, p.edc_check_energy, dbistats);
+    }
+
+    SatCounter8 &
+    DBICache::clbCounter(Addr addr)
+    {
+        return clbTable[rdbi->getRegDBITag(addr) % clbTable.size()];
+    }
+
+    bool
+    DBICache::clbPredictMiss(Addr addr)
+    {
+        // Predict a miss when the counter is in its upper half
+        return clbCounter(addr).calcSaturation() >= 0.5;
+    }
+
+    Cycles
+    DBICache::clbMissLatency(PacketPtr pkt)
+    {
+        // Average latency of the misses of this command so far
+        // Before the first miss returns, only the latency of the path through the cache is known
+        const auto &cmd_stats = stats.cmdStats(pkt);
+        const double misses = cmd_stats.misses.total();
+        if (misses == 0)
+            return lookupLatency + forwardLatency + responseLatency;
+        return ticksToCycles(Tick(cmd_stats.missLatency.total() / misses));
+    }
+
+    void
+    DBICache::doWritebacks(PacketList &writebacks, Tick forward_time)
+    {
+        // Drain the writebacks of the RDBI entries evicted by the previous accesses first
+        writebacks.splice(writebacks.begin(), pendingWritebacks);
+        Cache::doWritebacks(writebacks, forward_time);
+    }
+
+    void
+    DBICache::doWritebacksAtomic(PacketList &writebacks)
+    {
+        // Drain the writebacks of the RDBI entries evicted by the previous accesses first
+        writebacks.splice(writebacks.begin(), pendingWritebacks);
+        Cache::doWritebacksAtomic(writebacks);
+    }
+
+    void
+    DBICache::queueWriteback(PacketPtr wbPkt)
+    {
+        // If this cache is not the one accessing the shared DBI, nothing else sends the writeback
+        pendingWritebacks.push_back(wbPkt);
+        schedulePendingWritebacks();
+    }
+
+    void
+    DBICache::schedulePendingWritebacks()
+    {
+        if (!pendingWritebacks.empty() && !pendingWritebackEvent.scheduled())
+            schedule(pendingWritebackEvent, clockEdge());
+    }
+
+    void
+    DBICache::sendPendingWritebacks()
+    {
+        // The queued writebacks are spliced in by doWritebacks, unless an access already sent them
+        PacketList writebacks;
+        if (system->isTimingMode())
+            doWritebacks(writebacks, clockEdge(forwardLatency));
+        else
+            doWritebacksAtomic(writebacks);
+
+        if (drainState() == DrainState::Draining)
+        {
+            DPRINTF(Drain, "%s sent its pending writebacks, done draining\n", name());
+            signalDrainDone();
+        }
+    }
+
+    DrainState
+    DBICache::drain()
+    {
+        // The writebacks still waiting for the next doWritebacks call are sent by pendingWritebackEvent
+        if (pendingWritebacks.empty())
+            return DrainState::Drained;
+
+        DPRINTF(Drain, "%s has %d pending writebacks, draining\n", name(), pendingWritebacks.size());
+        schedulePendingWritebacks();
+        return DrainState::Draining;
+    }
+
+    bool
+    DBICache::anyDirtyBlk() const
+    {
+        if (sharedDBI)
+            return static_cast<const SharedRDBI *>(rdbi)->anyDirty(this);
+        return rdbi->anyDirty();
+    }
+
+    void
+    DBICache::forEachDirtyBlk(std::function<void(CacheBlk &)> visitor) const
+    {
+        if (sharedDBI)
+            static_cast<const SharedRDBI *>(rdbi)->forEachDirtyBlk(this, visitor);
+        else
+            rdbi->forEachDirtyBlk(visitor);
+    }
+
+    unsigned
+    DBICache::dirtyBlksInRegion(Addr addr) const
+    {
+        return rdbi->numDirtyBlks(rdbi->lookup(addr));
+    }
+
+    bool
+    DBICache::isBlkDirty(const CacheBlk *blk) const
+    {
+        return rdbi->isDirty(rdbi->lookup(regenerateBlkAddr(blk)));
+    }
+
+    void
+    DBICache::setBlkDirty(CacheBlk *blk, const PacketPtr pkt)
+    {
+        RDBILookup dbiLookup = rdbi->lookup(regenerateBlkAddr(blk));
+        rdbi->setDirtyBit(dbiLookup, pkt, blk, pendingWritebacks);
+        schedulePendingWritebacks();
+        idleWritebackBlkDirtied(blk);
+    }
+
+    void
+    DBICache::idleWritebackBlkDirtied(const CacheBlk *blk)
+    {
+        if (!idleWritebackEnabled)
+            return;
+
+        // A block cleaned at idle time and written again was written back for nothing
+        if (idleCleanedBlks.erase(regenerateBlkAddr(blk)))
+            dbistats.idleWritebackRedirtied++;
+        scheduleIdleWriteback();
+    }
+
+    void
+    DBICache::clearBlkDirty(CacheBlk *blk)
+    {
+        const Addr addr = regenerateBlkAddr(blk);
+
+        if (idleWritebackEnabled)
+            idleCleanedBlks.erase(addr);
+
+        // Nothing to look up while the RDBI tracks no dirty block, e.g., when memInvalidate walks the tags
+        if (!rdbi->anyDirty())
+            return;
+
+        // The block is written back, passed on or invalidated by the caller
+        // Only drop its dirty bit and block pointer, without writing back the region
+        rdbi->invalidateBlk(rdbi->lookup(addr), dirtyClearCause);
+    }
+
+    void
+    DBICache::idleWriteback()
+    {
+        // Do not issue writebacks while the system drains, drainResume restarts the engine
+        if (drainState() != DrainState::Running)
+            return;
+
+        // The memory side is idle when no miss and no writeback of this cache is queued
+        // This only sees the local queues: a miss or writeback waiting for a retry of the memory side stays
+        // in them, but the traffic of the other requestors of the memory side is not seen
+        if (writeBuffer.isEmpty() && mshrQueue.isEmpty())
+        {
+            PacketList writebacks;
+            const unsigned int numBlks = rdbi->cleanRegion(writebacks, idleWritebackMaxBlks);
+            if (numBlks > 0)
+            {
+                // A shared RDBI queues the writebacks of this cache with the pending ones
+                // The blocks of the other slices are sent, and tracked, by their slices
+                writebacks.splice(writebacks.end(), pendingWritebacks);
+                DPRINTF(DBICache, "Idle-time writeback of %d blocks\n", numBlks);
+                dbistats.idleWritebackRegions++;
+                dbistats.idleWritebackBlks += numBlks;
+                for (const auto &wbPkt : writebacks)
+                {
+                    if (wbPkt->cmd == MemCmd::WriteClean)
+                        idleCleanedBlks.insert(wbPkt->getAddr());
+                }
+                doWritebacks(writebacks, clockEdge(forwardLatency));
+            }
+        }
+
+        // Keep checking while there is something to clean
+        if (anyDirtyBlk())
+            scheduleIdleWriteback();
+    }
+
+    void
+    DBICache::scheduleIdleWriteback()
+    {
+        if (!idleWritebackEvent.scheduled() && system->isTimingMode())
+            schedule(idleWritebackEvent, clockEdge(idleWritebackPeriod));
+    }
+
+    void
+    DBICache::serialize(CheckpointOut &cp) const
+    {
+        // The dirty blocks are checkpointed. drain() sends the pending writebacks, so only a cache
+        // checkpointed without draining would lose them
+        bool bad_checkpoint = !pendingWritebacks.empty();
+        if (bad_checkpoint)
+        {
+            warn("*** %s still has %d writebacks to send. ***\n", name(), pendingWritebacks.size());
+            warn("    This checkpoint will not restore correctly and their data will be lost!\n");
+        }
+        SERIALIZE_SCALAR(bad_checkpoint);
+
+        // A shared RDBI is not checkpointed, each slice marks its dirty blocks again on restore
+        if (!sharedDBI)
+            rdbi->serializeSection(cp, "rdbi");
+
+        // Address, security, permissions and data of every dirty block, region by region
+        std::vector<Addr> dirtyBlkAddrs;
+        std::vector<uint8_t> dirtyBlkSecure;
+        std::vector<unsigned int> dirtyBlkBits;
+        std::vector<uint8_t> dirtyBlkData;
+        forEachDirtyBlk([&](CacheBlk &blk)
+                        {
+                            dirtyBlkAddrs.push_back(regenerateBlkAddr(&blk));
+                            dirtyBlkSecure.push_back(blk.isSecure());
+                            dirtyBlkBits.push_back(
+                                (blk.isSet(CacheBlk::WritableBit) ? CacheBlk::WritableBit : 0) |
+                                (blk.isSet(CacheBlk::ReadableBit) ? CacheBlk::ReadableBit : 0));
+                            dirtyBlkData.insert(dirtyBlkData.end(), blk.data, blk.data + blkSize);
+                        });
+        SERIALIZE_CONTAINER(dirtyBlkAddrs);
+        SERIALIZE_CONTAINER(dirtyBlkSecure);
+        SERIALIZE_CONTAINER(dirtyBlkBits);
+        SERIALIZE_CONTAINER(dirtyBlkData);
+    }
+
+    void
+    DBICache::unserialize(CheckpointIn &cp)
+    {
+        bool bad_checkpoint;
+        UNSERIALIZE_SCALAR(bad_checkpoint);
+        fatal_if(bad_checkpoint, "%s had writebacks to send when the checkpoint was taken, "
+                                 "their data is not in the checkpoint.\n", name());
+
+        if (!sharedDBI)
+            rdbi->unserializeSection(cp, "rdbi");
+
+        std::vector<Addr> dirtyBlkAddrs;
+        std::vector<uint8_t> dirtyBlkSecure;
+        std::vector<unsigned int> dirtyBlkBits;
+        std::vector<uint8_t> dirtyBlkData;
+        UNSERIALIZE_CONTAINER(dirtyBlkAddrs);
+        UNSERIALIZE_CONTAINER(dirtyBlkSecure);
+        UNSERIALIZE_CONTAINER(dirtyBlkBits);
+        UNSERIALIZE_CONTAINER(dirtyBlkData);
+        fatal_if(dirtyBlkSecure.size() != dirtyBlkAddrs.size() || dirtyBlkBits.size() != dirtyBlkAddrs.size() ||
+                     dirtyBlkData.size() != dirtyBlkAddrs.size() * blkSize,
+                 "%s: the checkpointed dirty blocks do not match the block size\n", name());
+
+        // Put the dirty blocks back in the tag store, and point the RDBI to them
+        for (unsigned int i = 0; i < dirtyBlkAddrs.size(); i++)
+        {
+            const Addr addr = dirtyBlkAddrs[i];
+            const bool is_secure = dirtyBlkSecure[i];
+
+            RequestPtr req = Request::create(addr, blkSize, 0, Request::wbRequestorId);
+            if (is_secure)
+                req->setFlags(Request::SECURE);
+            Packet pkt(req, MemCmd::WritebackDirty);
+
+            std::vector<CacheBlk *> evict_blks;
+            CacheBlk *blk = tags->findVictim(addr, is_secure, blkSize * 8, evict_blks);
+            fatal_if(!blk || blk->isValid() || !evict_blks.empty(),
+                     "%s: no room to restore block %#x, the tag store does not match the checkpoint\n",
+                     name(), addr);
+
+            tags->insertBlock(&pkt, blk);
+            blk->setCoherenceBits(dirtyBlkBits[i]);
+            std::memcpy(blk->data, &dirtyBlkData[i * blkSize], blkSize);
+
+            if (sharedDBI)
+            {
+                // The regions fitted in the shared RDBI when the checkpoint was taken, so no region is evicted
+                rdbi->setDirtyBit(&pkt, blk, pendingWritebacks);
+                continue;
+            }
+
+            fatal_if(!rdbi->restoreBlkPtr(rdbi->lookup(addr), blk),
+                     "%s: block %#x is dirty but the checkpointed RDBI does not track it\n", name(), addr);
+        }
+
+        if (sharedDBI)
+            return;
+
+        // Dirty bits without a block cannot be written back, drop them
+        const unsigned int numDropped = rdbi->dropUnmappedBlks();
+        warn_if(numDropped, "%s: dropped %d dirty bits of the checkpointed RDBI with no block\n",
+                name(), numDropped);
+    }
+
+    void
+    DBICache::drainResume()
+    {
+        Cache::drainResume();
+
+        if (idleWritebackEnabled && anyDirtyBlk())
+            scheduleIdleWriteback();
+    }
+
+    PacketPtr
+    DBICache::evictBlock(CacheBlk *blk)
+    {
+        // With aggressive writeback, evicting a dirty block writes back the other dirty blocks of its region
+        // They stay in the cache as clean blocks, so later replacements can pick them without a writeback
+        if (useAggressiveWriteback && blk->isValid() && isBlkDirty(blk))
+        {
+            rdbi->writebackRegion(rdbi->lookup(regenerateBlkAddr(blk)), pendingWritebacks);
+            schedulePendingWritebacks();
+        }
+
+        return Cache::evictBlock(blk);
+    }
+
+    void
+    DBICache::memWriteback()
+    {
+        // Only the blocks of the regions tracked by the RDBI can be dirty
+        // Write them back region by region, instead of visiting every block of the tag store
+        dirtyClearCause = RDBIFlush;
+        forEachDirtyBlk([this](CacheBlk &blk)
+                        { writebackVisitor(blk); });
+        dirtyClearCause = RDBIWriteback;
+
+        // The writebacks queued by the RDBI no longer have a block, write their data like writebackVisitor
+        for (PacketPtr wbPkt : pendingWritebacks)
+        {
+            if (wbPkt->hasData())
+            {
+                Packet packet(wbPkt->req, MemCmd::WriteReq);
+                packet.dataStatic(wbPkt->getPtr<uint8_t>());
+                memSidePort.sendFunctional(&packet);
+            }
+            delete wbPkt;
+        }
+        pendingWritebacks.clear();
+    }
+
+    void
+    DBICache::memInvalidate()
+    {
+        // The dirty blocks are found in the RDBI rather than by a dirty check of every block. Like
+        // invalidateVisitor, invalidating them loses their data. Their dirty state is dropped
+        // first, so that the tag walk below does no RDBI lookup.
+        std::vector<CacheBlk *> dirtyBlks;
+        forEachDirtyBlk([&dirtyBlks](CacheBlk &blk)
+                        { dirtyBlks.push_back(&blk); });
+        if (!dirtyBlks.empty())
+        {
+            warn_once("Invalidating dirty cache lines. Expect things to break.\n");
+            dirtyClearCause = RDBIFlush;
+            for (CacheBlk *blk : dirtyBlks)
+                clearBlkDirty(blk);
+            dirtyClearCause = RDBIWriteback;
+        }
+
+        // Every valid block is invalidated, and only the tags know the valid blocks
+        tags->forEachBlk([this](CacheBlk &blk)
+                         {
+                             if (blk.isValid())
+                                 invalidateBlock(&blk);
+                         });
+    }
+
+    void
+    DBICache::recvTimingSnoopReq(PacketPtr pkt)
+    {
+        // Dirty blocks passed on or invalidated by the snoop are recorded as such in the DBI stats
+        dirtyClearCause = RDBISnoop;
+        Cache::recvTimingSnoopReq(pkt);
+        dirtyClearCause = RDBIWriteback;
+    }
+
+    Tick
+    DBICache::recvAtomicSnoop(PacketPtr pkt)
+    {
+        dirtyClearCause = RDBISnoop;
+        Tick snoop_delay = Cache::recvAtomicSnoop(pkt);
+        dirtyClearCause = RDBIWriteback;
+        return snoop_delay;
+    }
+
+    bool
+    DBICache::isDirty() const
+    {
+        return anyDirtyBlk();
     }
 
     // cmpAndSwap function
@@ -108,8 +531,9 @@ namespace gem5
         {
             std::memcpy(blk_data, &overwrite_val, pkt->getSize());
             // blk->setCoherenceBits(CacheBlk::DirtyBit);
-            PacketList writebacks;
-            rdbi->setDirtyBit(pkt, blk, writebacks);
+            rdbi->setDirtyBit(pkt, blk, pendingWritebacks);
+            schedulePendingWritebacks();
+            idleWritebackBlkDirtied(blk);
 
             if (ppDataUpdate->hasListeners())
             {
@@ -138,6 +562,9 @@ namespace gem5
         // assert(!pkt->needsWritable() || blk->isSet(CacheBlk::WritableBit));
         assert(pkt->getOffset(blkSize) + pkt->getSize() <= blkSize);
 
+        // Look up the RDBI once, and reuse the handle for all the dirty bit operations below
+        RDBILookup dbiLookup = rdbi->lookup(pkt->getAddr());
+
         // Check RMW operations first since both isRead() and
         // isWrite() will be true for them
         if (pkt->cmd == MemCmd::SwapReq)
@@ -173,8 +600,9 @@ namespace gem5
                 // set block status to dirty
                 // blk->setCoherenceBits(CacheBlk::DirtyBit);
                 // blk->setCoherenceBits(CacheBlk::DirtyBit);
-                PacketList writebacks;
-                rdbi->setDirtyBit(pkt, blk, writebacks);
+                rdbi->setDirtyBit(dbiLookup, pkt, blk, pendingWritebacks);
+                schedulePendingWritebacks();
+                idleWritebackBlkDirtied(blk);
             }
             else
             {
@@ -200,8 +628,9 @@ namespace gem5
 
             // blk->setCoherenceBits(CacheBlk::DirtyBit);
             // blk->setCoherenceBits(CacheBlk::DirtyBit);
-            PacketList writebacks;
-            rdbi->setDirtyBit(pkt, blk, writebacks);
+            rdbi->setDirtyBit(dbiLookup, pkt, blk, pendingWritebacks);
+            schedulePendingWritebacks();
+            idleWritebackBlkDirtied(blk);
 
             DPRINTF(CacheVerbose, "%s for %s (write)\n", __func__, pkt->print());
         }
@@ -223,7 +652,7 @@ namespace gem5
 
             // if (blk->isSet(CacheBlk::DirtyBit))
             // Replacing the above line with the following lines
-            if (rdbi->isDirty(pkt))
+            if (rdbi->isDirty(dbiLookup))
             {
                 // we were in the Owned state, and a cache above us that
                 // has the line in Shared state needs to be made aware
@@ -231,15 +660,15 @@ namespace gem5
                 pkt->setCacheResponding();
 
                 // blk->clearCoherenceBits(CacheBlk::DirtyBit);
-                PacketList writebacks;
-                rdbi->clearDirtyBit(pkt, writebacks);
+                rdbi->clearDirtyBit(dbiLookup, pendingWritebacks, RDBITransfer);
+                schedulePendingWritebacks();
             }
         }
         else if (pkt->isClean())
         {
             // blk->clearCoherenceBits(CacheBlk::DirtyBit);
-            PacketList writebacks;
-            rdbi->clearDirtyBit(pkt, writebacks);
+            rdbi->clearDirtyBit(dbiLookup, pendingWritebacks, RDBIWriteback);
+            schedulePendingWritebacks();
         }
         else
         {
@@ -269,12 +698,12 @@ namespace gem5
 
                     // if (blk->isSet(CacheBlk::DirtyBit))
                     //  Replace the above line with the following line
-                    if (rdbi->isDirty(pkt))
+                    if (rdbi->isDirty(dbiLookup))
                     {
                         pkt->setCacheResponding();
                         // blk->clearCoherenceBits(CacheBlk::DirtyBit);
-                        PacketList writebacks;
-                        rdbi->clearDirtyBit(pkt, writebacks);
+                        rdbi->clearDirtyBit(dbiLookup, pendingWritebacks, RDBITransfer);
+                        schedulePendingWritebacks();
                     }
                 }
                 else if (blk->isSet(CacheBlk::WritableBit) &&
@@ -294,7 +723,7 @@ namespace gem5
 
                     // if (blk->isSet(CacheBlk::DirtyBit))
                     //  Replace the above line with the following line
-                    if (rdbi->isDirty(pkt))
+                    if (rdbi->isDirty(dbiLookup))
                     {
                         // special considerations if we're owner:
                         if (!deferred_response)
@@ -320,8 +749,8 @@ namespace gem5
                             // branches
 
                             // blk->clearCoherenceBits(CacheBlk::DirtyBit);
-                            PacketList writebacks;
-                            rdbi->clearDirtyBit(pkt, writebacks);
+                            rdbi->clearDirtyBit(dbiLookup, pendingWritebacks, RDBITransfer);
+                            schedulePendingWritebacks();
                         }
                         else
                         {
@@ -420,8 +849,9 @@ namespace gem5
 
                         // blk->setCoherenceBits(CacheBlk::DirtyBit);
                         // blk->setCoherenceBits(CacheBlk::DirtyBit);
-                        PacketList writebacks;
-                        rdbi->setDirtyBit(pkt, blk, writebacks);
+                        rdbi->setDirtyBit(pkt, blk, pendingWritebacks);
+                        schedulePendingWritebacks();
+                        idleWritebackBlkDirtied(blk);
 
                         panic_if(isReadOnly, "Prefetch exclusive requests from "
                                              "read-only cache %s\n",
@@ -723,6 +1153,7 @@ namespace gem5
                 // blk->setCoherenceBits(CacheBlk::DirtyBit);
                 // Replace the above line with the following
                 rdbi->setDirtyBit(pkt, blk, writebacks);
+                idleWritebackBlkDirtied(blk);
 
                 gem5_assert(!isReadOnly, "Should never see dirty snoop response "
                                          "in read-only cache %s\n",
@@ -835,12 +1266,14 @@ namespace gem5
 
         bool respond = false;
         bool blk_valid = blk && blk->isValid();
+        // Look up the RDBI once, and reuse the handle for the dirty checks below
+        const RDBILookup dbiLookup = rdbi->lookup(pkt->getAddr());
         if (pkt->isClean())
         {
 
             // if (blk_valid && blk->isSet(CacheBlk::DirtyBit))
             // Replace the above line with the following
-            if (blk_valid && rdbi->isDirty(pkt))
+            if (blk_valid && rdbi->isDirty(dbiLookup))
             {
                 DPRINTF(CacheVerbose, "%s: packet (snoop) %s found block: %s\n",
                         __func__, pkt->print(), blk->print());
@@ -898,13 +1331,13 @@ namespace gem5
 
             // respond = blk->isSet(CacheBlk::DirtyBit) && pkt->needsResponse();
             // Replace the above line with the following
-            respond = rdbi->isDirty(pkt) && pkt->needsResponse();
+            respond = rdbi->isDirty(dbiLookup) && pkt->needsResponse();
 
             // gem5_assert(!(isReadOnly && blk->isSet(CacheBlk::DirtyBit)),
             //            "Should never have a dirty block in a read-only cache %s\n",
             //            name());
             // Replace the above line with the following
-            gem5_assert(!(isReadOnly && rdbi->isDirty(pkt)),
+            gem5_assert(!(isReadOnly && rdbi->isDirty(dbiLookup)),
                         "Should never have a dirty block in a read-only cache %s\n",
                         name());
         }
@@ -1010,97 +1443,6 @@ namespace gem5
         return snoop_delay;
     }
 
-    Tick
-    DBICache::recvAtomic(PacketPtr pkt)
-    {
-        // Print statement for debugging
-        // cout << "DBICache::recvAtomic" << endl;
-        // should assert here that there are no outstanding MSHRs or
-        // writebacks... that would mean that someone used an atomic
-        // access in timing mode
-
-        // We use lookupLatency here because it is used to specify the latency
-        // to access.
-        Cycles lat = lookupLatency;
-
-        CacheBlk *blk = nullptr;
-        PacketList writebacks;
-        bool satisfied = access(pkt, blk, lat, writebacks);
-
-        // if (pkt->isClean() && blk && blk->isSet(CacheBlk::DirtyBit))
-        // Replace the above line with the following
-        if (pkt->isClean() && blk && rdbi->isDirty(pkt))
-        {
-            // A cache clean opearation is looking for a dirty
-            // block. If a dirty block is encountered a WriteClean
-            // will update any copies to the path to the memory
-            // until the point of reference.
-            DPRINTF(CacheVerbose, "%s: packet %s found block: %s\n",
-                    __func__, pkt->print(), blk->print());
-            PacketPtr wb_pkt = writecleanBlk(blk, pkt->req->getDest(), pkt->id);
-            writebacks.push_back(wb_pkt);
-            pkt->setSatisfied();
-        }
-
-        // handle writebacks resulting from the access here to ensure they
-        // logically precede anything happening below
-        doWritebacksAtomic(writebacks);
-        assert(writebacks.empty());
-
-        if (!satisfied)
-        {
-            lat += handleAtomicReqMiss(pkt, blk, writebacks);
-        }
-
-        // Note that we don't invoke the prefetcher at all in atomic mode.
-        // It's not clear how to do it properly, particularly for
-        // prefetchers that aggressively generate prefetch candidates and
-        // rely on bandwidth contention to throttle them; these will tend
-        // to pollute the cache in atomic mode since there is no bandwidth
-        // contention.  If we ever do want to enable prefetching in atomic
-        // mode, though, this is the place to do it... see timingAccess()
-        // for an example (though we'd want to issue the prefetch(es)
-        // immediately rather than calling requestMemSideBus() as we do
-        // there).
-
-        // do any writebacks resulting from the response handling
-        doWritebacksAtomic(writebacks);
-
-        // if we used temp block, check to see if its valid and if so
-        // clear it out, but only do so after the call to recvAtomic is
-        // finished so that any downstream observers (such as a snoop
-        // filter), first see the fill, and only then see the eviction
-        if (blk == tempBlock && tempBlock->isValid())
-        {
-            // the atomic CPU calls recvAtomic for fetch and load/store
-            // sequentuially, and we may already have a tempBlock
-            // writeback from the fetch that we have not yet sent
-            if (tempBlockWriteback)
-            {
-                // if that is the case, write the prevoius one back, and
-                // do not schedule any new event
-                writebackTempBlockAtomic();
-            }
-            else
-            {
-                // the writeback/clean eviction happens after the call to
-                // recvAtomic has finished (but before any successive
-                // calls), so that the response handling from the fill is
-                // allowed to happen first
-                schedule(writebackTempBlockAtomicEvent, curTick());
-            }
-
-            tempBlockWriteback = evictBlock(blk);
-        }
-
-        if (pkt->needsResponse())
-        {
-            pkt->makeAtomicResponse();
-        }
-
-        return lat * clockPeriod();
-    }
-
     bool
     DBICache::access(PacketPtr pkt, CacheBlk *&blk, Cycles &lat,
                      PacketList &writebacks)
@@ -1140,10 +1482,55 @@ namespace gem5
                     "Should never see a write in a read-only cache %s\n",
                     name());
 
+        // Cache lookup bypass: a read predicted to miss is only checked in the DBI, and sent to the memory side
+        // without waiting for the tag lookup. This is only safe if the block is clean, as the memory then holds its latest data
+        // This is a latency-only model: the tags are still accessed to keep their state, and the outcome of the
+        // lookup sets the latency charged to the bypassed read
+        // Only timing accesses have a lookup latency to hide, atomic accesses skip the predictor
+        const bool clb_read = clbEnabled && system->isTimingMode() && pkt->isRead() && !pkt->isWrite() && !pkt->req->isCacheMaintenance();
+        const bool clb_bypass = clb_read && clbPredictMiss(pkt->getAddr()) && !rdbi->isDirty(pkt);
+
         // Access block in the tags
         Cycles tag_latency(0);
         blk = tags->accessBlock(pkt, tag_latency);
 
+        if (clb_read)
+        {
+            // Train the miss predictor with the outcome of the lookup
+            if (blk)
+                clbCounter(pkt->getAddr())--;
+            else
+                clbCounter(pkt->getAddr())++;
+
+            if (clb_bypass)
+            {
+                dbistats.clbPredictedMisses++;
+                Cycles bypass_latency = clbDBILatency;
+                if (!blk)
+                {
+                    dbistats.clbCorrectPredictions++;
+                }
+                else
+                {
+                    // The block is clean, so the bypassed read still gets the right data, but from the memory side
+                    // It is charged the miss it went through instead of the hit it skipped
+                    dbistats.clbMispredictions++;
+                    bypass_latency += clbMissLatency(pkt);
+                }
+
+                if (bypass_latency < tag_latency)
+                    dbistats.clbCyclesSaved += tag_latency - bypass_latency;
+                else
+                    dbistats.clbCyclesLost += bypass_latency - tag_latency;
+                tag_latency = bypass_latency;
+            }
+        }
+
+        // A shared DBI is looked up in parallel with the tags, but it is farther away and its ports are shared
+        // The access takes the longer of the two lookups
+        if (sharedDBI)
+            tag_latency = std::max(tag_latency, ticksToCycles(sharedDBI->access(system->isTimingMode())));
+
         DPRINTF(Cache, "%s for %s %s\n", __func__, pkt->print(),
                 blk ? "hit " + blk->print() : "miss");
 
@@ -1279,6 +1666,7 @@ namespace gem5
                 // Replace the above line with the following
 
                 rdbi->setDirtyBit(pkt, blk, writebacks);
+                idleWritebackBlkDirtied(blk);
             }
             // if the packet does not have sharers, it is passing
             // writable, and we got the writeback in Modified or Exclusive
@@ -1377,6 +1765,7 @@ namespace gem5
                 // blk->setCoherenceBits(CacheBlk::DirtyBit);
                 // Replace the above line with the following
                 rdbi->setDirtyBit(pkt, blk, writebacks);
+                idleWritebackBlkDirtied(blk);
             }
             // nothing else to do; writeback doesn't expect response
             assert(!pkt->needsResponse());
@@ -1411,6 +1800,12 @@ namespace gem5
                 {
                     lat += compressor->getDecompressionLatency(blk);
                 }
+
+                // Check the code of the block, an ECC if it is dirty and an EDC otherwise
+                if (eccEnabled)
+                {
+                    lat += ecc->checkRead(rdbi->isDirty(pkt));
+                }
             }
             else
             {
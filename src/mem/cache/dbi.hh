@@ -2,11 +2,17 @@
 #define _MEM_CACHE_DBI_HH_
 
 #include <cstdint>
+#include <functional>
+#include <unordered_set>
+#include <vector>
 
+#include "base/sat_counter.hh"
 #include "base/types.hh"
 #include "mem/cache/cache.hh"
+#include "mem/cache/dbi_ecc.hh"
 #include "mem/packet.hh"
 #include "mem/cache/rdbi/rdbi.hh"
+#include "mem/cache/rdbi/shared_dbi.hh"
 #include "mem/cache/base.hh"
 
 using namespace std;
@@ -18,6 +24,8 @@ namespace gem5
     // A class named RDBI, which stands for region-level DBI,
     // is responsible for maintaining the dirty bit for a region in memory.
     class RDBI;
+    // A DBI shared by the slices of a cache
+    class SharedDBI;
 
     class DBICache : public Cache
     {
@@ -61,6 +69,87 @@ namespace gem5
         // Use aggressive writeback mechanism.
         bool useAggressiveWriteback;
 
+        // Use the cache lookup bypass (CLB)
+        // Reads predicted to miss on a clean block take the DBI lookup latency instead of the tag lookup latency
+        const bool clbEnabled;
+        // Latency of the DBI lookup of a bypassed read
+        const Cycles clbDBILatency;
+        // Miss predictor of the CLB, one saturating counter per group of regions
+        // A counter is incremented on a miss and decremented on a hit
+        std::vector<SatCounter8> clbTable;
+
+        // Get the miss predictor counter of the region of an address
+        SatCounter8 &clbCounter(Addr addr);
+        // Predict if an access misses in the cache
+        bool clbPredictMiss(Addr addr);
+        // Latency charged to a mispredicted bypass, which goes to the memory side although the block hits
+        Cycles clbMissLatency(PacketPtr pkt);
+
+        // Model the heterogeneous ECC of the DBI
+        const bool eccEnabled;
+        // Heterogeneous ECC model, also reporting the ECC storage when disabled
+        DBIECC *ecc;
+
+        // Idle-time writeback engine
+        // While nothing is queued towards memory, the least recently written region is cleaned,
+        // at most once per period and at most a write buffer worth of blocks at a time
+        const bool idleWritebackEnabled;
+        const Cycles idleWritebackPeriod;
+        const unsigned int idleWritebackMaxBlks;
+        EventFunctionWrapper idleWritebackEvent;
+        // Blocks cleaned at idle time that are still in the cache, to count the ones written again
+        std::unordered_set<Addr> idleCleanedBlks;
+
+        // Clean a region if the memory side is idle, and keep checking while some block is dirty
+        void idleWriteback();
+        // Schedule the next check of the idle-time writeback engine
+        void scheduleIdleWriteback();
+        // Start the engine after a block was made dirty, and count the idle-time writebacks it wasted
+        // Called by every path that sets a dirty bit in the RDBI
+        void idleWritebackBlkDirtied(const CacheBlk *blk);
+
+        // Cause recorded in the DBI stats when a block is no longer dirty, set around snoops and flushes
+        RDBIEvictionCause dirtyClearCause;
+
+        // Writebacks generated by the RDBI on paths that do not carry a writeback list,
+        // e.g., satisfyRequest, cmpAndSwap and handleSnoop.
+        // They are sent with the writebacks of the next doWritebacks call, at the latest on the next
+        // clock edge by pendingWritebackEvent, so that a drained cache holds none of them.
+        PacketList pendingWritebacks;
+        EventFunctionWrapper pendingWritebackEvent;
+        // Schedule pendingWritebackEvent if a writeback is pending, after every RDBI update that may queue one
+        void schedulePendingWritebacks();
+        void sendPendingWritebacks();
+
+        // DBI shared with the other slices of the cache, if any
+        // Its RDBI also tracks the blocks of the other slices, and queues each writeback in the slice holding the block
+        SharedDBI *sharedDBI;
+
+        // Check if a block of this cache is dirty, and visit the dirty blocks of this cache
+        bool anyDirtyBlk() const;
+        void forEachDirtyBlk(std::function<void(CacheBlk &)> visitor) const;
+
+        void doWritebacks(PacketList &writebacks, Tick forward_time) override;
+        void doWritebacksAtomic(PacketList &writebacks) override;
+
+        // The dirty state of the blocks is kept in the RDBI rather than in the blocks
+        bool isBlkDirty(const CacheBlk *blk) const override;
+        void setBlkDirty(CacheBlk *blk, const PacketPtr pkt) override;
+        void clearBlkDirty(CacheBlk *blk) override;
+
+        // Evict a block, with aggressive writeback the other dirty blocks of its region are written back too
+        [[nodiscard]] PacketPtr evictBlock(CacheBlk *blk) override;
+
+        // The flush, the dirty checks and the dirty blocks of an invalidation only visit the regions tracked
+        // by the RDBI. Invalidation still visits every tag, as the valid blocks are only tracked by the tags.
+        void memWriteback() override;
+        void memInvalidate() override;
+        bool isDirty() const override;
+
+        // Snoops, so that the DBI stats tell the RDBI entries invalidated by a snoop
+        void recvTimingSnoopReq(PacketPtr pkt) override;
+        Tick recvAtomicSnoop(PacketPtr pkt) override;
+
         void cmpAndSwap(CacheBlk *blk, PacketPtr pkt);
         void satisfyRequest(PacketPtr pkt, CacheBlk *blk,
                             bool deferred_response = false,
@@ -75,8 +164,6 @@ namespace gem5
         uint32_t handleSnoop(PacketPtr pkt, CacheBlk *blk, bool is_timing,
                              bool is_deferred, bool pending_inval);
 
-        Tick recvAtomic(PacketPtr pkt);
-
         bool access(PacketPtr pkt, CacheBlk *&blk, Cycles &lat,
                     PacketList &writebacks);
 
@@ -89,6 +176,24 @@ namespace gem5
         DBICacheStats dbistats;
         // A constructor for the DBI augmented cache.
         DBICache(const DBICacheParams &p);
+
+        // Dirty-region hints for the prefetchers, answered by the RDBI
+        unsigned dirtyBlksInRegion(Addr addr) const override;
+        unsigned blksPerRegion() const override { return numBlksInRegion; }
+
+        // Queue a writeback of a block of this cache, generated by the shared RDBI
+        // It is sent with the next writebacks of the cache, at the latest on the next clock edge
+        void queueWriteback(PacketPtr wbPkt);
+
+        // Drained once the pending writebacks are sent
+        DrainState drain() override;
+        // Restart the idle-time writeback engine, it stops while the system is drained
+        void drainResume() override;
+
+        // Checkpoint the dirty blocks with the RDBI, so that a checkpoint of a dirty DBICache restores correctly
+        // Clean blocks are not checkpointed, the cache restarts with only its dirty blocks
+        void serialize(CheckpointOut &cp) const override;
+        void unserialize(CheckpointIn &cp) override;
         // BaseCache::CacheStats *cache_stats;
     };
 }
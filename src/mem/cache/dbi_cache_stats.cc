@@ -1,4 +1,7 @@
 #include "mem/cache/dbi_cache_stats.hh"
+
+#include <algorithm>
+
 #include "mem/cache/base.hh"
 #include "mem/cache/dbi.hh"
 #include "mem/cache/tags/base.hh"
@@ -10,14 +13,80 @@ using namespace std;
 namespace gem5
 {
     // constructor
-    DBICacheStats::DBICacheStats(DBICache &d, Stats::Group *parent)
+    RDBIStats::RDBIStats(Stats::Group *parent)
         : Stats::Group(parent), // initilizing the base class
-          ADD_STAT(writebacksGenerated, "Number of DBI writebacks")
+          ADD_STAT(writebacksGenerated, "Number of DBI writebacks"),
+          ADD_STAT(rdbiHits, "Number of dirty bit updates that found their region in the RDBI"),
+          ADD_STAT(rdbiMisses, "Number of dirty bit updates that inserted their region in the RDBI"),
+          ADD_STAT(rdbiHitRate, "Hit rate of the dirty bit updates in the RDBI"),
+          ADD_STAT(rdbiOccupancy, "Number of valid RDBI entries, sampled on dirty bit updates"),
+          ADD_STAT(dirtyBlksAtEviction, "Number of dirty blocks of the regions evicted from the RDBI"),
+          ADD_STAT(rdbiEvictions, "Number of RDBI entries invalidated, per cause"),
+          ADD_STAT(writebackBatches, "Number of RDBI region writebacks"),
+          ADD_STAT(avgWritebackBatchSize, "Average number of blocks of an RDBI region writeback"),
+          ADD_STAT(rdbiSetConflicts, "Number of RDBI entries evicted for another region, per set")
 
     {
         // Writebacks generated
         writebacksGenerated
             .flags(Stats::total);
+
+        // RDBI, the distributions are sized by the RDBI
+        rdbiHitRate = rdbiHits / (rdbiHits + rdbiMisses);
+        rdbiEvictions
+            .init(NumRDBIEvictionCauses)
+            .subname(RDBICapacity, "capacity")
+            .subname(RDBIAggressiveWriteback, "aggressiveWriteback")
+            .subname(RDBIWriteback, "writeback")
+            .subname(RDBITransfer, "transfer")
+            .subname(RDBISnoop, "snoop")
+            .subname(RDBIFlush, "flush")
+            .subname(RDBIIdleWriteback, "idleWriteback")
+            .flags(Stats::total | Stats::nozero);
+        avgWritebackBatchSize = writebacksGenerated / writebackBatches;
+        rdbiSetConflicts
+            .flags(Stats::total | Stats::nozero);
+    }
+
+    void
+    RDBIStats::initDistributions(unsigned int numEntries, unsigned int numBlksInRegion, unsigned int numSets)
+    {
+        rdbiOccupancy.init(0, numEntries, std::max(1u, numEntries / 16));
+        dirtyBlksAtEviction.init(std::min(numBlksInRegion, 16u));
+        rdbiSetConflicts.init(numSets);
+    }
+
+    // constructor
+    DBICacheStats::DBICacheStats(DBICache &d, Stats::Group *parent)
+        : RDBIStats(parent), // initilizing the base class
+          ADD_STAT(clbPredictedMisses, "Number of reads predicted to miss on a clean block by the cache lookup bypass"),
+          ADD_STAT(clbCorrectPredictions, "Number of predicted misses that did miss"),
+          ADD_STAT(clbMispredictions, "Number of predicted misses that hit"),
+          ADD_STAT(clbCyclesSaved, "Number of lookup cycles saved by the cache lookup bypass"),
+          ADD_STAT(clbCyclesLost, "Number of cycles lost by the cache lookup bypass, mostly on mispredictions"),
+          ADD_STAT(clbAccuracy, "Accuracy of the cache lookup bypass miss predictor"),
+          ADD_STAT(eccChecks, "Number of ECC checks on reads of dirty blocks"),
+          ADD_STAT(edcChecks, "Number of error detection checks on reads of clean blocks"),
+          ADD_STAT(eccCheckCycles, "Number of cycles spent checking codes on reads"),
+          ADD_STAT(eccCheckEnergy, "Energy spent checking codes on reads (pJ)"),
+          ADD_STAT(eccCodes, "Number of ECC codes, one per block the DBI can track"),
+          ADD_STAT(eccStorageBits, "Check bits stored with heterogeneous ECC"),
+          ADD_STAT(uniformECCStorageBits, "Check bits stored with an ECC for every block"),
+          ADD_STAT(eccStorageSavings, "Fraction of the check bits saved by heterogeneous ECC"),
+          ADD_STAT(idleWritebackRegions, "Number of RDBI regions cleaned, up to write_buffers blocks at a time, while the memory side was idle"),
+          ADD_STAT(idleWritebackBlks, "Number of blocks written back while the memory side was idle"),
+          ADD_STAT(idleWritebackRedirtied, "Number of blocks cleaned at idle time that were written again while in the cache"),
+          ADD_STAT(idleWritebackWasteRate, "Fraction of the idle-time writebacks that were wasted by a later write")
+
+    {
+        // Cache lookup bypass
+        clbAccuracy = clbCorrectPredictions / clbPredictedMisses;
+
+        // Heterogeneous ECC
+        eccStorageSavings = 1 - eccStorageBits / uniformECCStorageBits;
+
+        // Idle-time writeback engine
+        idleWritebackWasteRate = idleWritebackRedirtied / idleWritebackBlks;
     }
 
     // Print the stats
@@ -26,5 +95,9 @@ namespace gem5
     {
         cout << "DBI Cache Stats" << endl;
         cout << "Writebacks generated: " << writebacksGenerated.value() << endl;
+        cout << "CLB predicted misses: " << clbPredictedMisses.value() << endl;
+        cout << "CLB mispredictions: " << clbMispredictions.value() << endl;
+        cout << "CLB cycles saved: " << clbCyclesSaved.value() << endl;
+        cout << "CLB cycles lost: " << clbCyclesLost.value() << endl;
     }
 }
\ No newline at end of file
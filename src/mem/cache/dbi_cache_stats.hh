@@ -12,11 +12,49 @@ namespace gem5
 {
     class DBICache;
 
+    // Stats of an RDBI, part of the DBI stats of a cache, or of a SharedDBI when the RDBI is shared
+    struct RDBIStats : public Stats::Group
+    {
+        RDBIStats(Stats::Group *parent); // constructor
+        // Size the distributions from the geometry of the RDBI
+        void initDistributions(unsigned int numEntries, unsigned int numBlksInRegion, unsigned int numSets);
+        Stats::Scalar writebacksGenerated;
+        Stats::Scalar rdbiHits;
+        Stats::Scalar rdbiMisses;
+        Stats::Formula rdbiHitRate;
+        Stats::Distribution rdbiOccupancy;
+        Stats::Histogram dirtyBlksAtEviction;
+        Stats::Vector rdbiEvictions;
+        Stats::Scalar writebackBatches;
+        Stats::Formula avgWritebackBatchSize;
+        Stats::Vector rdbiSetConflicts;
+    };
+
     // Defining the a stat group
-    struct DBICacheStats : public Stats::Group
+    struct DBICacheStats : public RDBIStats
     {
         DBICacheStats(DBICache &d, Stats::Group *parent); // constructor
-        Stats::Scalar writebacksGenerated;
+        // Cache lookup bypass
+        Stats::Scalar clbPredictedMisses;
+        Stats::Scalar clbCorrectPredictions;
+        Stats::Scalar clbMispredictions;
+        Stats::Scalar clbCyclesSaved;
+        Stats::Scalar clbCyclesLost;
+        Stats::Formula clbAccuracy;
+        // Heterogeneous ECC
+        Stats::Scalar eccChecks;
+        Stats::Scalar edcChecks;
+        Stats::Scalar eccCheckCycles;
+        Stats::Scalar eccCheckEnergy;
+        Stats::Value eccCodes;
+        Stats::Value eccStorageBits;
+        Stats::Value uniformECCStorageBits;
+        Stats::Formula eccStorageSavings;
+        // Idle-time writeback engine stats
+        Stats::Scalar idleWritebackRegions;
+        Stats::Scalar idleWritebackBlks;
+        Stats::Scalar idleWritebackRedirtied;
+        Stats::Formula idleWritebackWasteRate;
         // Print the stats
         void printDBICacheStats(DBICache &d);
     };
@@ -0,0 +1,42 @@
+#include "mem/cache/dbi_ecc.hh"
+
+namespace gem5
+{
+
+    DBIECC::DBIECC(uint64_t numBlksInCache, uint64_t numBlksInDBI, unsigned int _eccBitsPerBlk, unsigned int _edcBitsPerBlk, Cycles _eccCheckLatency, Cycles _edcCheckLatency, double _eccCheckEnergy, double _edcCheckEnergy, DBICacheStats &dbistats)
+        : numECCCodes(numBlksInDBI),
+          eccBitsPerBlk(_eccBitsPerBlk),
+          edcBitsPerBlk(_edcBitsPerBlk),
+          eccCheckLatency(_eccCheckLatency),
+          edcCheckLatency(_edcCheckLatency),
+          eccCheckEnergy(_eccCheckEnergy),
+          edcCheckEnergy(_edcCheckEnergy),
+          dbiCacheStats(&dbistats)
+    {
+        // Every block keeps an EDC, and the RDBI can track at most numBlksInDBI dirty blocks, each needing an ECC
+        storageBits = numECCCodes * eccBitsPerBlk + numBlksInCache * edcBitsPerBlk;
+        // Without the DBI, every block needs an ECC
+        uniformStorageBits = numBlksInCache * eccBitsPerBlk;
+
+        dbiCacheStats->eccCodes.scalar(numECCCodes);
+        dbiCacheStats->eccStorageBits.scalar(storageBits);
+        dbiCacheStats->uniformECCStorageBits.scalar(uniformStorageBits);
+    }
+
+    Cycles
+    DBIECC::checkRead(bool dirty)
+    {
+        if (dirty)
+        {
+            dbiCacheStats->eccChecks++;
+            dbiCacheStats->eccCheckCycles += eccCheckLatency;
+            dbiCacheStats->eccCheckEnergy += eccCheckEnergy;
+            return eccCheckLatency;
+        }
+
+        dbiCacheStats->edcChecks++;
+        dbiCacheStats->eccCheckCycles += edcCheckLatency;
+        dbiCacheStats->eccCheckEnergy += edcCheckEnergy;
+        return edcCheckLatency;
+    }
+}
@@ -0,0 +1,51 @@
+#ifndef _MEM_CACHE_DBI_ECC_HH_
+#define _MEM_CACHE_DBI_ECC_HH_
+
+#include <cstdint>
+
+#include "base/types.hh"
+#include "mem/cache/dbi_cache_stats.hh"
+
+namespace gem5
+{
+    // Heterogeneous ECC model of a DBI augmented cache
+    // Only dirty blocks need a strong error correcting code (ECC), as a clean block can be re-fetched from memory
+    // Clean blocks only keep an error detecting code (EDC), e.g., parity
+    // The DBI bounds the number of dirty blocks, so the ECC storage is sized from the RDBI instead of the cache
+    // The protection of a block is given by its dirty bit in the RDBI, so it is not stored in the cache blocks
+    class DBIECC
+    {
+    protected:
+        // Number of ECC codes, one per block that the RDBI can track
+        uint64_t numECCCodes;
+        // Number of check bits of the ECC of a dirty block
+        unsigned int eccBitsPerBlk;
+        // Number of check bits of the EDC of a block
+        unsigned int edcBitsPerBlk;
+
+        // Latency of the ECC check on reads of dirty blocks
+        const Cycles eccCheckLatency;
+        // Latency of the EDC check on reads of clean blocks
+        const Cycles edcCheckLatency;
+        // Energy of an ECC check, in pJ
+        const double eccCheckEnergy;
+        // Energy of an EDC check, in pJ
+        const double edcCheckEnergy;
+
+        // Storage of the check bits, with heterogeneous ECC and with an ECC for every cache block
+        uint64_t storageBits;
+        uint64_t uniformStorageBits;
+
+        // DBI Cache Stats
+        DBICacheStats *dbiCacheStats;
+
+    public:
+        // Constructor
+        DBIECC(uint64_t numBlksInCache, uint64_t numBlksInDBI, unsigned int _eccBitsPerBlk, unsigned int _edcBitsPerBlk, Cycles _eccCheckLatency, Cycles _edcCheckLatency, double _eccCheckEnergy, double _edcCheckEnergy, DBICacheStats &dbistats);
+
+        // Check the code of a block that is read, and return the latency of the check
+        Cycles checkRead(bool dirty);
+    };
+}
+
+#endif // _MEM_CACHE_DBI_ECC_HH_
@@ -353,7 +353,7 @@ NoncoherentCache::evictBlock(CacheBlk *blk)
     // If we clean writebacks are not enabled, we do not take any
     // further action for evictions of clean blocks (i.e., CleanEvicts
     // are unnecessary).
-    PacketPtr pkt = (blk->isSet(CacheBlk::DirtyBit) || writebackClean) ?
+    PacketPtr pkt = (isBlkDirty(blk) || writebackClean) ?
         writebackBlk(blk) : nullptr;
 
     invalidateBlock(blk);
@@ -44,6 +44,11 @@ from m5.objects.ClockedObject import ClockedObject
 from m5.objects.IndexingPolicies import *
 from m5.objects.ReplacementPolicies import *
 
+# What a queued prefetcher does with a prefetch that would evict a dirty
+# block, or that targets a mostly dirty DBI region
+class DirtyVictimFilter(Enum): vals = ['allow_dirty_victims',
+    'drop_dirty_victims', 'deprioritize_dirty_victims']
+
 class HWPProbeEvent(object):
     def __init__(self, prefetcher, obj, *listOfNames):
         self.obj = obj
@@ -133,6 +138,15 @@ class QueuedPrefetcher(BasePrefetcher):
     queue_filter = Param.Bool(True, "Don't queue redundant prefetches")
     cache_snoop = Param.Bool(False, "Snoop cache to eliminate redundant request")
 
+    # Prefetches that would evict a dirty block cause write traffic. They
+    # can be dropped, or given the lowest priority so that they are issued
+    # last and replaced first. With a DBI, the prefetches into a region with
+    # at least dirty_region_threshold of its blocks dirty are filtered too
+    dirty_victim_filter = Param.DirtyVictimFilter('allow_dirty_victims',
+        "Filter prefetches that would evict a dirty block")
+    dirty_region_threshold = Param.Float(1.0, "Fraction of dirty blocks of "
+        "a DBI region from which its prefetches are filtered")
+
     tag_prefetch = Param.Bool(True, "Tag prefetch with PC of generating access")
 
     # The throttle_control_percentage controls how many of the candidate
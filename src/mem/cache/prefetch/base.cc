@@ -142,7 +142,9 @@ Base::StatGroup::StatGroup(statistics::Group *parent)
     ADD_STAT(pfHitInWB, statistics::units::Count::get(),
         "number of prefetches hit in the Write Buffer"),
     ADD_STAT(pfLate, statistics::units::Count::get(),
-        "number of late prefetches (hitting in cache, MSHR or WB)")
+        "number of late prefetches (hitting in cache, MSHR or WB)"),
+    ADD_STAT(pfDirtyEvictions, statistics::units::Count::get(),
+        "number of dirty blocks evicted, and written back, by prefetch fills")
 {
     using namespace statistics;
 
@@ -203,6 +205,21 @@ Base::hasBeenPrefetched(Addr addr, bool is_secure) const
     return cache->hasBeenPrefetched(addr, is_secure);
 }
 
+bool
+Base::evictsDirtyBlock(Addr addr, bool is_secure) const
+{
+    return cache->fillEvictsDirty(addr, is_secure);
+}
+
+double
+Base::dirtyRegionFraction(Addr addr) const
+{
+    const unsigned blks_per_region = cache->blksPerRegion();
+    if (blks_per_region == 0)
+        return 0;
+    return (double)cache->dirtyBlksInRegion(addr) / blks_per_region;
+}
+
 bool
 Base::samePage(Addr a, Addr b) const
 {
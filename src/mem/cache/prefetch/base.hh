@@ -316,6 +316,15 @@ class Base : public ClockedObject
 
     bool hasBeenPrefetched(Addr addr, bool is_secure) const;
 
+    /** Determine if filling address would evict a dirty block */
+    bool evictsDirtyBlock(Addr addr, bool is_secure) const;
+
+    /**
+     * Fraction of the blocks of the DBI region of address that are dirty,
+     * 0 if the cache has no DBI.
+     */
+    double dirtyRegionFraction(Addr addr) const;
+
     /** Determine if addresses are on the same page */
     bool samePage(Addr a, Addr b) const;
     /** Determine the address of the block in which a lays */
@@ -357,6 +366,10 @@ class Base : public ClockedObject
         /** The number of times a HW-prefetch is late
          * (hit in cache, MSHR, WB). */
         statistics::Formula pfLate;
+
+        /** The number of dirty blocks evicted, and written back, to make
+         * room for a HW-prefetch. */
+        statistics::Scalar pfDirtyEvictions;
     } prefetchStats;
 
     /** Total prefetches issued */
@@ -417,6 +430,12 @@ class Base : public ClockedObject
         prefetchStats.pfHitInWB++;
     }
 
+    void
+    pfDirtyEviction()
+    {
+        prefetchStats.pfDirtyEvictions++;
+    }
+
     /**
      * Register probe points for this object.
      */
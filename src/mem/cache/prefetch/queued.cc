@@ -38,6 +38,7 @@
 #include "mem/cache/prefetch/queued.hh"
 
 #include <cassert>
+#include <limits>
 
 #include "arch/generic/tlb.hh"
 #include "base/logging.hh"
@@ -61,8 +62,8 @@ Queued::DeferredPacket::createPkt(Addr paddr, unsigned blk_size,
                                             bool tag_prefetch,
                                             Tick t) {
     /* Create a prefetch memory request */
-    RequestPtr req = std::make_shared<Request>(paddr, blk_size,
-                                                0, requestor_id);
+    RequestPtr req = Request::create(paddr, blk_size,
+                                     0, requestor_id);
 
     if (pfInfo.isSecure()) {
         req->setFlags(Request::SECURE);
@@ -105,7 +106,9 @@ Queued::Queued(const QueuedPrefetcherParams &p)
       latency(p.latency), queueSquash(p.queue_squash),
       queueFilter(p.queue_filter), cacheSnoop(p.cache_snoop),
       tagPrefetch(p.tag_prefetch),
-      throttleControlPct(p.throttle_control_percentage), statsQueued(this)
+      throttleControlPct(p.throttle_control_percentage),
+      dirtyVictimFilter(p.dirty_victim_filter),
+      dirtyRegionThreshold(p.dirty_region_threshold), statsQueued(this)
 {
 }
 
@@ -278,10 +281,42 @@ Queued::QueuedStats::QueuedStats(statistics::Group *parent)
     ADD_STAT(pfSpanPage, statistics::units::Count::get(),
              "number of prefetches that crossed the page"),
     ADD_STAT(pfUsefulSpanPage, statistics::units::Count::get(),
-             "number of prefetches that is useful and crossed the page")
+             "number of prefetches that is useful and crossed the page"),
+    ADD_STAT(pfDirtyVictimDropped, statistics::units::Count::get(),
+             "number of prefetches dropped as they would evict a dirty block"),
+    ADD_STAT(pfDirtyVictimDeprioritized, statistics::units::Count::get(),
+             "number of prefetches deprioritized as they would evict a "
+             "dirty block")
 {
 }
 
+bool
+Queued::filterDirtyVictim(Addr paddr, bool is_secure, int32_t &priority)
+{
+    if (dirtyVictimFilter == enums::allow_dirty_victims) {
+        return true;
+    }
+
+    // The dirty region hint is only given by caches with a DBI, and is
+    // cheaper than looking up the victim
+    if (dirtyRegionFraction(paddr) < dirtyRegionThreshold &&
+            !evictsDirtyBlock(paddr, is_secure)) {
+        return true;
+    }
+
+    if (dirtyVictimFilter == enums::drop_dirty_victims) {
+        statsQueued.pfDirtyVictimDropped++;
+        DPRINTF(HWPrefetch, "Dropping prefetch addr:%#x, it would evict a "
+                "dirty block\n", paddr);
+        return false;
+    }
+
+    // Issued last, and replaced first when the queue is full
+    statsQueued.pfDirtyVictimDeprioritized++;
+    priority = std::numeric_limits<int32_t>::min();
+    return true;
+}
+
 
 void
 Queued::processMissingTranslations(unsigned max)
@@ -321,7 +356,8 @@ Queued::translationComplete(DeferredPacket *dp, bool failed)
             statsQueued.pfInCache++;
             DPRINTF(HWPrefetch, "Dropping redundant in "
                     "cache/MSHR prefetch addr:%#x\n", target_paddr);
-        } else {
+        } else if (filterDirtyVictim(target_paddr, it->pfInfo.isSecure(),
+                                     it->priority)) {
             Tick pf_time = curTick() + clockPeriod() * latency;
             it->createPkt(target_paddr, blkSize, requestorId, tagPrefetch,
                           pf_time);
@@ -374,7 +410,7 @@ RequestPtr
 Queued::createPrefetchRequest(Addr addr, PrefetchInfo const &pfi,
                                         PacketPtr pkt)
 {
-    RequestPtr translation_req = std::make_shared<Request>(
+    RequestPtr translation_req = Request::create(
             addr, blkSize, pkt->req->getFlags(), requestorId, pfi.getPC(),
             pkt->req->contextId());
     translation_req->setFlags(Request::PREFETCH);
@@ -459,6 +495,10 @@ Queued::insert(const PacketPtr &pkt, PrefetchInfo &new_pfi,
                 "cache/MSHR prefetch addr:%#x\n", target_paddr);
         return;
     }
+    if (has_target_pa &&
+            !filterDirtyVictim(target_paddr, new_pfi.isSecure(), priority)) {
+        return;
+    }
 
     /* Create the packet and find the spot to insert it */
     DeferredPacket dpp(this, new_pfi, 0, priority);
@@ -45,6 +45,7 @@
 #include "arch/generic/mmu.hh"
 #include "base/statistics.hh"
 #include "base/types.hh"
+#include "enums/DirtyVictimFilter.hh"
 #include "mem/cache/prefetch/base.hh"
 #include "mem/packet.hh"
 
@@ -175,6 +176,15 @@ class Queued : public Base
     /** Percentage of requests that can be throttled */
     const unsigned int throttleControlPct;
 
+    /** What to do with prefetches that would evict a dirty block */
+    const enums::DirtyVictimFilter dirtyVictimFilter;
+
+    /**
+     * Fraction of dirty blocks of a DBI region above which the prefetches
+     * into the region are filtered as well
+     */
+    const double dirtyRegionThreshold;
+
     struct QueuedStats : public statistics::Group
     {
         QueuedStats(statistics::Group *parent);
@@ -186,6 +196,8 @@ class Queued : public Base
         statistics::Scalar pfRemovedFull;
         statistics::Scalar pfSpanPage;
         statistics::Scalar pfUsefulSpanPage;
+        statistics::Scalar pfDirtyVictimDropped;
+        statistics::Scalar pfDirtyVictimDeprioritized;
     } statsQueued;
   public:
     using AddrPriority = std::pair<Addr, int32_t>;
@@ -235,6 +247,17 @@ class Queued : public Base
      */
     void translationComplete(DeferredPacket *dp, bool failed);
 
+    /**
+     * Apply the dirty victim filter to a prefetch: drop it, or lower its
+     * priority, if it would evict a dirty block or targets a mostly dirty
+     * DBI region.
+     * @param paddr physical address of the prefetch
+     * @param is_secure whether the prefetch is to secure memory
+     * @param priority priority of the prefetch, lowered if deprioritized
+     * @return false if the prefetch has to be dropped
+     */
+    bool filterDirtyVictim(Addr paddr, bool is_secure, int32_t &priority);
+
     /**
      * Checks whether the specified prefetch request is already in the
      * specified queue. If the request is found, its priority is updated.
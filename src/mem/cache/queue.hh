@@ -46,9 +46,12 @@
 #define __MEM_CACHE_QUEUE_HH__
 
 #include <cassert>
+#include <cstdint>
 #include <string>
 #include <type_traits>
+#include <vector>
 
+#include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/named.hh"
 #include "base/trace.hh"
@@ -101,6 +104,68 @@ class Queue : public Drainable, public Named
     /** Holds non allocated entries. */
     typename Entry::List freeList;
 
+    /**
+     * Index of the allocated entries by block address. Each bucket
+     * holds the first entry of a chain, chained through hashNext,
+     * and the entries of a chain are kept in allocation order, so
+     * that a lookup returns the same entry as a scan of the
+     * allocatedList.
+     */
+    std::vector<Entry*> hashBuckets;
+    /** Next entry in the chain of each entry, by entry index. */
+    std::vector<Entry*> hashNext;
+    /** Shift of the hashed address that gives the bucket. */
+    const int hashShift;
+
+    /**
+     * Get the bucket of a block address.
+     *
+     * @param blk_addr The block address.
+     * @return The index of the bucket.
+     */
+    size_t bucketIndex(Addr blk_addr) const
+    {
+        // Multiplicative hashing, the low bits of block addresses are
+        // all zero
+        return (blk_addr * 0x9E3779B97F4A7C15ULL) >> hashShift;
+    }
+
+    size_t entryIndex(const Entry* entry) const
+    {
+        return entry - entries.data();
+    }
+
+    /**
+     * Add a newly allocated entry to the address index, after the
+     * entries of its chain.
+     *
+     * @param entry The allocated entry.
+     */
+    void addToIndex(Entry* entry)
+    {
+        Entry** link = &hashBuckets[bucketIndex(entry->blkAddr)];
+        while (*link) {
+            link = &hashNext[entryIndex(*link)];
+        }
+        *link = entry;
+        hashNext[entryIndex(entry)] = nullptr;
+    }
+
+    /**
+     * Remove an entry from the address index.
+     *
+     * @param entry The entry being deallocated.
+     */
+    void removeFromIndex(Entry* entry)
+    {
+        Entry** link = &hashBuckets[bucketIndex(entry->blkAddr)];
+        while (*link != entry) {
+            assert(*link);
+            link = &hashNext[entryIndex(*link)];
+        }
+        *link = hashNext[entryIndex(entry)];
+    }
+
     typename Entry::Iterator addToReadyList(Entry* entry)
     {
         if (readyList.empty() ||
@@ -135,6 +200,9 @@ class Queue : public Drainable, public Named
         Named(name),
         label(_label), numEntries(num_entries + reserve),
         numReserve(reserve), entries(numEntries, name + ".entry"),
+        hashBuckets(size_t(2) << ceilLog2(numEntries), nullptr),
+        hashNext(numEntries, nullptr),
+        hashShift(64 - floorLog2(hashBuckets.size())),
         _numInService(0), allocated(0)
     {
         for (int i = 0; i < numEntries; ++i) {
@@ -168,7 +236,10 @@ class Queue : public Drainable, public Named
     Entry* findMatch(Addr blk_addr, bool is_secure,
                      bool ignore_uncacheable = true) const
     {
-        for (const auto& entry : allocatedList) {
+        // Only the chain of the address may hold a match, in
+        // allocation order
+        for (Entry* entry = hashBuckets[bucketIndex(blk_addr)]; entry;
+             entry = hashNext[entryIndex(entry)]) {
             // we ignore any entries allocated for uncacheable
             // accesses and simply ignore them when matching, in the
             // cache we never check for matches when adding new
@@ -206,12 +277,26 @@ class Queue : public Drainable, public Named
      */
     Entry* findPending(const QueueEntry* entry) const
     {
-        for (const auto& ready_entry : readyList) {
-            if (ready_entry->conflictAddr(entry)) {
-                return ready_entry;
+        // The entries of the readyList are the allocated entries that
+        // are not in service, look for them in the chain of the address
+        Entry* match = nullptr;
+        for (Entry* ready_entry = hashBuckets[bucketIndex(entry->blkAddr)];
+             ready_entry; ready_entry = hashNext[entryIndex(ready_entry)]) {
+            if (!ready_entry->inService && ready_entry->conflictAddr(entry)) {
+                if (match) {
+                    // Several entries conflict, the earliest one is the
+                    // first of the readyList
+                    for (const auto& ready : readyList) {
+                        if (ready->conflictAddr(entry)) {
+                            return ready;
+                        }
+                    }
+                    panic("Conflicting entry not in the ready list.");
+                }
+                match = ready_entry;
             }
         }
-        return nullptr;
+        return match;
     }
 
     /**
@@ -241,6 +326,7 @@ class Queue : public Drainable, public Named
     deallocate(Entry *entry)
     {
         allocatedList.erase(entry->allocIter);
+        removeFromIndex(entry);
         freeList.push_front(entry);
         allocated--;
         if (entry->inService) {
@@ -0,0 +1,15 @@
+from m5.params import *
+from m5.proxy import *
+from m5.objects.IndexingPolicies import SetAssociative, SkewedAssociative
+
+# Indexing policies of the RDBI. An RDBI entry tracks a region, so the entry
+# size is the region size and the associativity is the one of the DBI. The
+# size is the number of bytes tracked by the RDBI (alpha * size of the cache)
+# and must be set, e.g., RDBISkewedAssociative(size='512kB')
+class RDBISetAssociative(SetAssociative):
+    entry_size = Parent.blkSize * Parent.blk_per_dbi_entry
+    assoc = Parent.dbi_assoc
+
+class RDBISkewedAssociative(SkewedAssociative):
+    entry_size = Parent.blkSize * Parent.blk_per_dbi_entry
+    assoc = Parent.dbi_assoc
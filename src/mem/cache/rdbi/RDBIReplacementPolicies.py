@@ -0,0 +1,17 @@
+from m5.params import *
+from m5.objects.ReplacementPolicies import BaseReplacementPolicy
+
+# Replacement policies that only apply to the RDBI, as they choose the victim
+# region based on the number of dirty blocks tracked by each RDBI entry
+class DirtyBlocksRP(BaseReplacementPolicy):
+    type = 'DirtyBlocksRP'
+    cxx_class = 'gem5::replacement_policy::DirtyBlocks'
+    cxx_header = "mem/cache/rdbi/dirty_blocks_rp.hh"
+    evict_max_dirty = Param.Bool(True, "Evict the region with the most "
+        "dirty blocks, otherwise the one with the fewest")
+
+class MaxDirtyBlocksRP(DirtyBlocksRP):
+    evict_max_dirty = True
+
+class MinDirtyBlocksRP(DirtyBlocksRP):
+    evict_max_dirty = False
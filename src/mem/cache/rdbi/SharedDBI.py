@@ -0,0 +1,32 @@
+from m5.params import *
+from m5.proxy import *
+from m5.objects.ClockedObject import ClockedObject
+from m5.objects.ReplacementPolicies import LRURP
+
+# A DBI shared by the DBICache slices of a banked or sliced cache, set as
+# their shared_dbi. The slices interleave the addresses of a region, so a
+# shared RDBI lets a region writeback gather the dirty blocks of a DRAM row
+# from every slice. The slices must have disjoint addr_ranges, and the same
+# blkSize and blk_per_dbi_entry as the shared DBI.
+class SharedDBI(ClockedObject):
+    type = 'SharedDBI'
+    cxx_header = "mem/cache/rdbi/shared_dbi.hh"
+    cxx_class = 'gem5::SharedDBI'
+
+    # Same parameters as the DBI of a DBICache, the size is the total size
+    # of the slices
+    size = Param.MemorySize("Total size of the cache slices sharing the DBI")
+    blkSize = Param.MemorySize("Cache block size")
+    alpha = Param.Float("Alpha value for the DBI")
+    dbi_assoc = Param.Unsigned("Associativity of the DBI")
+    blk_per_dbi_entry = Param.Unsigned("Number of cache blocks per DBI entry")
+    aggr_writeback = Param.Bool("Use aggressive writeback mechanism")
+    dbi_replacement_policy = Param.BaseReplacementPolicy(LRURP(),
+        "Replacement policy of the RDBI entries")
+    dbi_indexing_policy = Param.BaseIndexingPolicy(NULL,
+        "Indexing policy of the RDBI entries")
+
+    # A lookup waits for one of the ports, each port starts one lookup per
+    # cycle, then takes latency cycles
+    latency = Param.Cycles(4, "Latency of a lookup of the shared DBI")
+    num_ports = Param.Unsigned(1, "Number of lookups started per cycle")
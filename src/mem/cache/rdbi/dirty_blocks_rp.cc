@@ -0,0 +1,85 @@
+#include "mem/cache/rdbi/dirty_blocks_rp.hh"
+
+#include <cassert>
+#include <memory>
+
+#include "mem/cache/rdbi/rdbi_entry.hh"
+#include "params/DirtyBlocksRP.hh"
+#include "sim/cur_tick.hh"
+
+namespace gem5
+{
+
+namespace replacement_policy
+{
+
+DirtyBlocks::DirtyBlocks(const Params &p)
+  : Base(p), evictMaxDirty(p.evict_max_dirty)
+{
+}
+
+void
+DirtyBlocks::invalidate(
+    const std::shared_ptr<ReplacementData>& replacement_data)
+{
+    // Reset last touch timestamp
+    std::static_pointer_cast<DirtyBlocksReplData>(
+        replacement_data)->lastTouchTick = Tick(0);
+}
+
+void
+DirtyBlocks::touch(
+    const std::shared_ptr<ReplacementData>& replacement_data) const
+{
+    // Update last touch timestamp
+    std::static_pointer_cast<DirtyBlocksReplData>(
+        replacement_data)->lastTouchTick = curTick();
+}
+
+void
+DirtyBlocks::reset(
+    const std::shared_ptr<ReplacementData>& replacement_data) const
+{
+    // Set last touch timestamp
+    std::static_pointer_cast<DirtyBlocksReplData>(
+        replacement_data)->lastTouchTick = curTick();
+}
+
+ReplaceableEntry*
+DirtyBlocks::getVictim(const ReplacementCandidates& candidates) const
+{
+    // There must be at least one replacement candidate
+    assert(candidates.size() > 0);
+
+    // Visit all candidates to find victim
+    ReplaceableEntry* victim = candidates[0];
+    unsigned victim_dirty = static_cast<RDBIEntry*>(victim)->numDirtyBlks;
+    for (const auto& candidate : candidates) {
+        const unsigned dirty =
+            static_cast<RDBIEntry*>(candidate)->numDirtyBlks;
+
+        // Prefer the entry with the most (or fewest) dirty blocks, and the
+        // least recently written one among entries with as many
+        const bool better = evictMaxDirty ? dirty > victim_dirty :
+                                            dirty < victim_dirty;
+        if (better || (dirty == victim_dirty &&
+                std::static_pointer_cast<DirtyBlocksReplData>(
+                    candidate->replacementData)->lastTouchTick <
+                std::static_pointer_cast<DirtyBlocksReplData>(
+                    victim->replacementData)->lastTouchTick)) {
+            victim = candidate;
+            victim_dirty = dirty;
+        }
+    }
+
+    return victim;
+}
+
+std::shared_ptr<ReplacementData>
+DirtyBlocks::instantiateEntry()
+{
+    return std::shared_ptr<ReplacementData>(new DirtyBlocksReplData());
+}
+
+} // namespace replacement_policy
+} // namespace gem5
@@ -0,0 +1,97 @@
+/**
+ * @file
+ * Declaration of the dirty-blocks replacement policies of the RDBI.
+ * The victim is the RDBI entry that tracks the most (max-dirty-blocks) or
+ * the fewest (min-dirty-blocks) dirty blocks of its region. Ties are broken
+ * by picking the least recently written region.
+ */
+
+#ifndef __MEM_CACHE_RDBI_DIRTY_BLOCKS_RP_HH__
+#define __MEM_CACHE_RDBI_DIRTY_BLOCKS_RP_HH__
+
+#include "base/types.hh"
+#include "mem/cache/replacement_policies/base.hh"
+
+namespace gem5
+{
+
+struct DirtyBlocksRPParams;
+
+namespace replacement_policy
+{
+
+class DirtyBlocks : public Base
+{
+  protected:
+    /** Dirty-blocks-specific implementation of replacement data. */
+    struct DirtyBlocksReplData : ReplacementData
+    {
+        /** Tick on which the entry was last written. */
+        Tick lastTouchTick;
+
+        /**
+         * Default constructor. Invalidate data.
+         */
+        DirtyBlocksReplData() : lastTouchTick(0) {}
+    };
+
+    /**
+     * Evict the entry with the most dirty blocks if set, otherwise the
+     * entry with the fewest dirty blocks.
+     */
+    const bool evictMaxDirty;
+
+  public:
+    typedef DirtyBlocksRPParams Params;
+    DirtyBlocks(const Params &p);
+    ~DirtyBlocks() = default;
+
+    /**
+     * Invalidate replacement data to set it as the next probable victim.
+     * Sets its last touch tick as the starting tick.
+     *
+     * @param replacement_data Replacement data to be invalidated.
+     */
+    void invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
+                                                                    override;
+
+    /**
+     * Touch an entry to update its replacement data.
+     * Sets its last touch tick as the current tick.
+     *
+     * @param replacement_data Replacement data to be touched.
+     */
+    void touch(const std::shared_ptr<ReplacementData>& replacement_data) const
+                                                                     override;
+
+    /**
+     * Reset replacement data. Used when an entry is inserted.
+     * Sets its last touch tick as the current tick.
+     *
+     * @param replacement_data Replacement data to be reset.
+     */
+    void reset(const std::shared_ptr<ReplacementData>& replacement_data) const
+                                                                     override;
+
+    /**
+     * Find replacement victim using the number of dirty blocks of each
+     * candidate. The candidates must be RDBI entries.
+     *
+     * @param candidates Replacement candidates, selected by indexing policy.
+     * @return Replacement entry to be replaced.
+     */
+    ReplaceableEntry* getVictim(const ReplacementCandidates& candidates) const
+                                                                     override;
+
+    /**
+     * Instantiate a replacement data entry.
+     *
+     * @return A shared pointer to the new replacement data.
+     */
+    std::shared_ptr<ReplacementData> instantiateEntry() override;
+};
+
+} // namespace replacement_policy
+} // namespace gem5
+
+#endif // __MEM_CACHE_RDBI_DIRTY_BLOCKS_RP_HH__
@@ -1,319 +1,303 @@
-
 #include "mem/cache/rdbi/rdbi.hh"
+
+#include <algorithm>
+
 #include "mem/cache/rdbi/rdbi_entry.hh"
+#include "base/bitfield.hh"
 #include "base/statistics.hh"
 #include "mem/cache/dbi.hh"
+#include "mem/cache/tags/indexing_policies/base.hh"
+#include "params/BaseIndexingPolicy.hh"
+#include "sim/cur_tick.hh"
 
 using namespace std;
 
 namespace gem5
 {
 
-    RDBI::RDBI(unsigned int _numSets, unsigned int _numBlkBits, unsigned int _numblkIndexBits, unsigned int _assoc, unsigned int _numBlksInRegion, unsigned int _blkSize, bool _useAggressiveWriteback, DBICacheStats &dbistats, DBICache &dbiCache)
-
+    RDBI::RDBI(unsigned int _numSets, unsigned int _numBlkBits, unsigned int _numblkIndexBits, unsigned int _assoc, unsigned int _numBlksInRegion, unsigned int _blkSize, bool _useAggressiveWriteback, replacement_policy::Base *_replacementPolicy, BaseIndexingPolicy *_indexingPolicy, RDBIStats &_rdbiStats, const std::string &_name)
+        : RDBIStore(_numSets, _numBlkBits, _numblkIndexBits, _assoc, _numBlksInRegion, _useAggressiveWriteback),
+          Named(_name)
     {
-        dbiCacheStats = &dbistats;
-        numSetBits = log2(_numSets);
-        numBlkBits = _numBlkBits;
-        // Bits required to index into DBI entries
-        numblkIndexBits = _numblkIndexBits;
-        Assoc = _assoc;
-        numBlksInRegion = _numBlksInRegion;
+        rdbiStats = &_rdbiStats;
         blkSize = _blkSize;
-        useAggressiveWriteback = _useAggressiveWriteback;
-        rDBIStore = vector<vector<RDBIEntry>>(_numSets, vector<RDBIEntry>(_assoc, RDBIEntry(numBlksInRegion)));
-    }
+        replacementPolicy = _replacementPolicy;
+        indexingPolicy = _indexingPolicy;
 
-    // Fetch the numBlkBits number of LHS bits from the packet address
-    unsigned int
-    RDBI::getBytesInBlock(PacketPtr pkt)
-    {
-        // Fetch the numBlkBits number of LHS bits from the packet address
-        Addr addr = pkt->getAddr();
-        // Obtain the total number of bits in the packet address
-        // int numAddrBits = sizeof(addr) * 8;
-        // Create a mask with 1's in the LHS numBlkBits bits and 0's in the rest numAddrBits - numBlkBits bits
-        Addr mask = ((1 << numBlkBits) - 1);
-        // Fetch the numBlkBits number of LHS bits from the packet address
-        Addr BytesInBlock = addr & mask;
-        return BytesInBlock;
+        // Give each entry its own replacement data
+        const unsigned int numEntries = entries.size();
+        for (auto &entry : entries)
+        {
+            entry.replacementData = replacementPolicy->instantiateEntry();
+        }
+
+        // Size the DBI stats of the RDBI
+        rdbiStats->initDistributions(numEntries, numBlksInRegion, numSets);
+
+        // An indexing policy must have one entry per RDBI entry, each as large as a region
+        if (indexingPolicy)
+        {
+            const BaseIndexingPolicyParams &indexingParams =
+                static_cast<const BaseIndexingPolicyParams &>(indexingPolicy->params());
+            fatal_if(indexingParams.assoc != Assoc ||
+                         indexingParams.entry_size != (blkSize << numblkIndexBits) ||
+                         indexingParams.size != uint64_t(numEntries) * (blkSize << numblkIndexBits),
+                     "The RDBI indexing policy must have size %d, entry_size %d and assoc %d\n",
+                     uint64_t(numEntries) * (blkSize << numblkIndexBits), blkSize << numblkIndexBits, Assoc);
+
+            // The indexing policy sets the position of each entry
+            for (unsigned int i = 0; i < numEntries; i++)
+            {
+                indexingPolicy->setEntry(&entries[i], i);
+            }
+        }
     }
 
-    unsigned int
-    RDBI::getBlocksInRegion(PacketPtr pkt)
+    int
+    RDBI::findEntry(const RDBILookup &dbiLookup) const
     {
-        // Fetch the packet address
-        Addr addr = pkt->getAddr();
-        // Remove the bytes in block field from the packet address
-        Addr temp = addr >> numBlkBits;
-        // Create a mask with 1's in the numblkIndexBits number of LHS bits and 0's in the rest numAddrBits - numblkIndexBits bits
-        Addr mask = (1 << numblkIndexBits) - 1;
-        // Fetch the blocks in region field from the packet address
-        Addr BlocksInRegion = temp & mask;
-        return BlocksInRegion;
+        if (!indexingPolicy)
+            return RDBIStore::findEntry(dbiLookup);
+
+        // Search the entries of the indexing policy for a valid entry of the region
+        for (const auto &candidate : indexingPolicy->getPossibleEntries(regenerateBlkAddr(dbiLookup.regTag, 0), possibleEntries))
+        {
+            const int i = getEntryIndex(candidate);
+            if (validBits[i] && regTags[i] == dbiLookup.regTag)
+                return i;
+        }
+        return -1;
     }
 
-    Addr
-    RDBI::getRegDBITag(PacketPtr pkt)
+    ReplacementCandidates
+    RDBI::getCandidates(const RDBILookup &dbiLookup)
     {
-        Addr addr = pkt->getAddr();
-        regAddr = addr >> (numBlkBits + numblkIndexBits);
-        return regAddr;
+        // With an indexing policy, the candidates may be in different sets
+        if (indexingPolicy)
+            return indexingPolicy->getPossibleEntries(regenerateBlkAddr(dbiLookup.regTag, 0));
+
+        return RDBIStore::getCandidates(dbiLookup);
     }
 
     int
-    RDBI::getRDBIEntryIndex(PacketPtr pkt)
+    RDBI::pickVictim(const ReplacementCandidates &candidates)
     {
-        regAddr = getRegDBITag(pkt);
-        // Use the LHS 5 bits of regAddr to index into the RDBI
-        int rDBIIndex = regAddr & ((1 << numSetBits) - 1);
-        return rDBIIndex;
+        // Return the index of the RDBIEntry chosen by the replacement policy
+        return getEntryIndex(replacementPolicy->getVictim(candidates));
     }
 
-    unsigned int
-    RDBI::getblkIndexInBitset(PacketPtr pkt)
+    void
+    RDBI::entryEvicted(int entryIndex)
     {
-        Addr addr = pkt->getAddr();
-        Addr temp = addr >> numBlkBits;
-        int bitmask = (1 << numblkIndexBits) - 1;
-        int blkIndexInBitset = temp & bitmask;
-
-        return blkIndexInBitset;
+        // DBI Stats
+        rdbiStats->rdbiSetConflicts[entries[entryIndex].getSet()]++;
+        rdbiStats->dirtyBlksAtEviction.sample(entries[entryIndex].numDirtyBlks);
     }
 
-    RDBIEntry *
-    RDBI::getRDBIEntry(PacketPtr pkt)
+    void
+    RDBI::entryInvalidated(int entryIndex, RDBIEvictionCause cause)
     {
-
-        // Get the block index from the bitset
-        blkIndexInBitset = getblkIndexInBitset(pkt);
-        regAddr = getRegDBITag(pkt);
-        // Identify the entry
-        rDBIIndex = getRDBIEntryIndex(pkt);
-        // Get the inner vector of DBI entries at the specified index location
-        vector<RDBIEntry> &rDBIEntries = rDBIStore[rDBIIndex];
-
-        // Iterate through the inner vector of DBI entries using an iterator
-        // Return the DBIEntry if it is found
-        for (vector<RDBIEntry>::iterator i = rDBIEntries.begin(); i != rDBIEntries.end(); ++i)
-        {
-            RDBIEntry &entry = *i;
-            if (entry.regTag == regAddr)
-            {
-                return &entry;
-            }
-        }
-
-        // Else return a null pointer
-        return nullptr;
+        // DBI Stats
+        rdbiStats->rdbiEvictions[cause]++;
+        replacementPolicy->invalidate(entries[entryIndex].replacementData);
     }
 
     void
-    RDBI::clearDirtyBit(PacketPtr pkt, PacketList &writebacks)
+    RDBI::regionWrittenBack(unsigned int numBlks)
     {
+        // DBI Stats
+        rdbiStats->writebackBatches++;
+        rdbiStats->writebacksGenerated += numBlks;
+    }
 
-        RDBIEntry *entry = getRDBIEntry(pkt);
-        // Check if a valid RDBI entry is found
-        if (entry != NULL)
-        {
-            // If the entry is valid
-            if (entry->validBit == 1)
-            {
-                // If the useAggressiveWriteback flag is set, writeback the entire region
-                // Then clear the dirty bits from the bitset
-                if (useAggressiveWriteback)
-                {
-                    // Fetch the value of the bytes in block field from the packet address
-                    // Store it in the bytesInBlock variable
-                    // bytesInBlock = getBytesInBlock(pkt);
-                    // Fetch the value of the blocks in region field from the packet address
-                    // Store it in the blocksInRegion variable
-                    blocksInRegion = getBlocksInRegion(pkt);
-                    // Set the numBlocksInRegionBits variable to the number of bits required to represent the number of blocks in a region
-                    numBlocksInRegionBits = log2(blocksInRegion);
-                    writebackRDBIEntry(writebacks, entry);
-                    entry->dirtyBits.reset();
-                }
+    bool
+    RDBI::isDirty(PacketPtr pkt) const
+    {
+        return isDirty(lookup(pkt->getAddr()));
+    }
 
-                // Else, clear the dirty bit from the bitset
-                else
-                {
-                    entry->dirtyBits.reset(blkIndexInBitset);
-                }
-            }
-        }
+    void
+    RDBI::clearDirtyBit(const RDBILookup &dbiLookup, PacketList &writebacks, RDBIEvictionCause cause)
+    {
+        clearDirty(dbiLookup, cause, packetWriteback(writebacks, MemCmd::WritebackDirty));
     }
 
     void
-    RDBI::setDirtyBit(PacketPtr pkt, CacheBlk *blkPtr, PacketList &writebacks)
+    RDBI::clearDirtyBit(PacketPtr pkt, PacketList &writebacks, RDBIEvictionCause cause)
     {
-        // Get the RDBI entry
-        RDBIEntry *entry = getRDBIEntry(pkt);
-        // Check if a valid RDBI entry is found
-        if (entry != NULL)
-        {
-            // If the entry is valid, set the dirty bit from the bitset
-            if (entry->validBit == 1)
-            {
-                entry->dirtyBits.set(blkIndexInBitset);
-                // Get the block pointer
-                entry->blkPtrs[blkIndexInBitset] = blkPtr;
-            }
-        }
+        clearDirtyBit(lookup(pkt->getAddr()), writebacks, cause);
+    }
 
+    void
+    RDBI::setDirtyBit(RDBILookup &dbiLookup, PacketPtr pkt, CacheBlk *blkPtr, PacketList &writebacks)
+    {
+        const bool hit = dbiLookup.hit();
+        // DBI Stats
+        if (hit)
+            rdbiStats->rdbiHits++;
         else
-        {
-            // If a valid RDBI entry is not found, create a new entry and set the dirty bit
-            createRDBIEntry(writebacks, pkt, blkPtr);
-            setDirtyBit(pkt, blkPtr, writebacks);
+            rdbiStats->rdbiMisses++;
+
+        markDirty(dbiLookup, blkPtr, curTick(), packetWriteback(writebacks, MemCmd::WritebackDirty));
+        rdbiStats->rdbiOccupancy.sample(numValidEntries);
+
+        // Set the replacement data of a new region, and update it on every write.
+        // Dirty state moved without a request (e.g. a compressed block moved to
+        // another entry) has no packet; policies such as SHiP need one, so use
+        // a synthetic write to the region.
+        std::unique_ptr<Packet> regionWrite;
+        if (pkt == nullptr) {
+            regionWrite = regionWritePacket(dbiLookup.entryIndex);
+            pkt = regionWrite.get();
         }
+        const auto &replacementData = entries[dbiLookup.entryIndex].replacementData;
+        if (!hit)
+            replacementPolicy->reset(replacementData, pkt);
+        replacementPolicy->touch(replacementData, pkt);
     }
 
-    bool
-    RDBI::isDirty(PacketPtr pkt)
+    std::unique_ptr<Packet>
+    RDBI::regionWritePacket(unsigned int entryIndex) const
     {
-        // Get the RDBI entry
-        RDBIEntry *entry = getRDBIEntry(pkt);
-
-        // Check if a valid RDBI entry is found
-        if (entry != NULL)
-        {
-            // If the entry is valid, check if the dirty bit is set
-            if (entry->validBit == 1)
-            {
-                // Check the entry's dirty bit from the bitset
-                return entry->dirtyBits.test(blkIndexInBitset);
-            }
-
-            else
-                return false;
-        }
+        RequestPtr req = Request::create(regenerateBlkAddr(regTags[entryIndex], 0), blkSize, 0,
+                                         Request::wbRequestorId);
+        return std::unique_ptr<Packet>(new Packet(req, MemCmd::WritebackDirty));
+    }
 
-        // If a valid RDBI entry is not found, return false
-        else
-            return false;
+    void
+    RDBI::setDirtyBit(PacketPtr pkt, CacheBlk *blkPtr, PacketList &writebacks)
+    {
+        RDBILookup dbiLookup = lookup(pkt->getAddr());
+        setDirtyBit(dbiLookup, pkt, blkPtr, writebacks);
     }
 
     void
-    RDBI::createRDBIEntry(PacketList &writebacks, PacketPtr pkt, CacheBlk *blkPtr)
+    RDBI::writebackRegion(const RDBILookup &dbiLookup, PacketList &writebacks)
     {
-        // Iterate through the inner vector of RDBI Entries
-        // Look for an invalid entry
-        // If an invalid entry is found, create a new entry
-        // If no invalid entry is found, evict an entry
+        writebackRegion(dbiLookup, packetWriteback(writebacks, MemCmd::WritebackDirty));
+    }
 
-        // From the packet address, stores the blocksInRegion field so that we can use it to re-generate the packet address
-        blocksInRegion = getBlocksInRegion(pkt);
+    unsigned int
+    RDBI::cleanRegion(PacketList &writebacks, unsigned int maxBlks)
+    {
+        return cleanRegion(maxBlks, packetWriteback(writebacks, MemCmd::WriteClean));
+    }
 
-        // Get the regAddr from the packet address
-        regAddr = getRegDBITag(pkt);
+    PacketPtr
+    RDBI::createWriteback(Addr addr, CacheBlk *blk, bool isRowBatch, MemCmd cmd) const
+    {
+        RequestPtr req = Request::create(
+            addr, blkSize, 0, Request::wbRequestorId);
 
-        // Get the index of the RDBI entry
-        rDBIIndex = getRDBIEntryIndex(pkt);
+        if (blk->isSecure())
+            req->setFlags(Request::SECURE);
 
-        // Get the inner vector of DBI entries at the specified index location
-        vector<RDBIEntry> &rDBIEntries = rDBIStore[rDBIIndex];
+        if (isRowBatch)
+            req->setFlags(Request::ROW_BATCH);
 
-        // Iterate through the inner vector of DBI entries using an iterator
-        // Fetch an invalid entry if found
-        // If no invalid entry is found at the end of the for loop, evict an entry
-        for (vector<RDBIEntry>::iterator i = rDBIEntries.begin(); i != rDBIEntries.end(); ++i)
-        {
-            RDBIEntry &entry = *i;
-            if (entry.validBit == 0)
-            {
-                // Create a new entry
-                entry.regTag = regAddr;
-                entry.validBit = 1;
-                entry.dirtyBits.set(blkIndexInBitset);
-                entry.blkPtrs[blkIndexInBitset] = blkPtr;
-                return;
-            }
-        }
+        req->taskId(blk->getTaskId());
 
-        // If no invalid entry is found, evict an entry
+        // Create a new packet and set the address to the cache block address
+        PacketPtr wbPkt = new Packet(req, cmd);
+        wbPkt->setAddr(addr);
 
-        evictRDBIEntry(writebacks, rDBIEntries);
-        createRDBIEntry(writebacks, pkt, blkPtr);
-    }
+        wbPkt->allocate();
+        wbPkt->setDataFromBlock(blk->data, blkSize);
 
-    RDBIEntry *
-    RDBI::pickRDBIEntry(vector<RDBIEntry> &rDBIEntries)
-    {
-        // Return the RDBIEntry returned by the replacement policy
-        return randomReplacementPolicy(rDBIEntries);
+        return wbPkt;
     }
 
-    RDBIEntry *
-    RDBI::randomReplacementPolicy(vector<RDBIEntry> &rDBIEntries)
+    void
+    RDBI::serialize(CheckpointOut &cp) const
     {
-        // Generate a random index within the range of the associativity of the set
-        int randomIndex = rand() % Assoc;
-        // Get the RDBIEntry at the generated index
-        RDBIEntry &entry = rDBIEntries[randomIndex];
-        return &entry;
+        // Geometry of the RDBI, checked on restore
+        unsigned int numEntries = entries.size();
+        SERIALIZE_SCALAR(numEntries);
+        SERIALIZE_SCALAR(numBlksInRegion);
+
+        SERIALIZE_CONTAINER(regTags);
+        SERIALIZE_CONTAINER(validBits);
+        SERIALIZE_CONTAINER(dirtyWords);
+
+        std::vector<Tick> lastWriteTicks(entries.size());
+        for (unsigned int i = 0; i < entries.size(); i++)
+            lastWriteTicks[i] = entries[i].lastWriteTick;
+        SERIALIZE_CONTAINER(lastWriteTicks);
     }
 
     void
-    RDBI::evictRDBIEntry(PacketList &writebacks, vector<RDBIEntry> &rDBIEntries)
+    RDBI::unserialize(CheckpointIn &cp)
     {
+        unsigned int numEntries;
+        unsigned int regionBlks;
+        UNSERIALIZE_SCALAR(numEntries);
+        paramIn(cp, "numBlksInRegion", regionBlks);
+        fatal_if(numEntries != entries.size() || regionBlks != numBlksInRegion,
+                 "%s: the checkpointed RDBI has %d entries of %d blocks, not %d entries of %d blocks\n",
+                 name(), numEntries, regionBlks, entries.size(), numBlksInRegion);
+
+        std::vector<Tick> lastWriteTicks;
+        UNSERIALIZE_CONTAINER(regTags);
+        UNSERIALIZE_CONTAINER(validBits);
+        UNSERIALIZE_CONTAINER(dirtyWords);
+        UNSERIALIZE_CONTAINER(lastWriteTicks);
+        fatal_if(regTags.size() != numEntries || validBits.size() != numEntries ||
+                     dirtyWords.size() != numEntries * wordsPerEntry || lastWriteTicks.size() != numEntries,
+                 "%s: the checkpointed RDBI arrays do not match its geometry\n", name());
+
+        // Rebuild the entries from the dirty bits
+        // The replacement data restarts from the restore, as if each region was inserted by a writeback,
+        // so that the policies needing an access (e.g., SHiP) can be restored. The block pointers are
+        // set by restoreBlkPtr.
+        numValidEntries = 0;
+        generation++;
+        fill(blkPtrs.begin(), blkPtrs.end(), nullptr);
+        for (unsigned int i = 0; i < numEntries; i++)
+        {
+            entries[i].numDirtyBlks = 0;
+            for (unsigned int w = 0; w < wordsPerEntry; w++)
+                entries[i].numDirtyBlks += popCount(dirtyWords[i * wordsPerEntry + w]);
+            entries[i].lastWriteTick = lastWriteTicks[i];
 
-        // Get the RDBIEntry to be evicted
-        RDBIEntry *entry = pickRDBIEntry(rDBIEntries);
-
-        // Generate writebacks for all the dirty cache blocks in the region
-        // Invalidate the RDBIEntry
-        // Set the numBlocksInRegionBits variable to the number of bits required to represent the number of blocks in a region
-        numBlocksInRegionBits = log2(blocksInRegion);
-        writebackRDBIEntry(writebacks, entry);
-        entry->validBit = 0;
+            if (validBits[i])
+            {
+                numValidEntries++;
+                replacementPolicy->reset(entries[i].replacementData, regionWritePacket(i).get());
+            }
+            else
+            {
+                replacementPolicy->invalidate(entries[i].replacementData);
+            }
+        }
     }
 
-    void
-    RDBI::writebackRDBIEntry(PacketList &writebacks, RDBIEntry *entry)
+    unsigned int
+    RDBI::dropUnmappedBlks()
     {
-
-        // Iterate over the bitset field of the RDBIEntry and check if any of the dirtyBit is set
-        // If a dirty bit is set, fetch the corresponding cache block pointer from the blkPtrs field
-        // Re-generate the cache block address from the rowTag
-        // Create a new packet and set the address to the cache block address
-        // Create a new request and set the requestor ID to the writeback requestor ID
-        // Create a new writeback packet and set the address to the cache block address
-        // Set the writeback packet's destination to the memory controller
-        // Push the writeback packet to the writebacks list
-        for (int i = 0; i < numBlksInRegion; i++)
+        unsigned int numDropped = 0;
+        for (unsigned int entryIndex = 0; entryIndex < entries.size(); entryIndex++)
         {
-            if (entry->dirtyBits.test(i))
-            {
-                // DBI Stats
-                dbiCacheStats->writebacksGenerated++;
-                // If there is a dirty bit set, fetch the cache block pointer corresponding to the dirtyBit in the blkPtrs field
-                CacheBlk *blk = entry->blkPtrs[i];
-
-                Addr addr = regenerateBlkAddr(entry->regTag, i);
-                RequestPtr req = std::make_shared<Request>(
-                    addr, blkSize, 0, Request::wbRequestorId);
-
-                if (blk->isSecure())
-                    req->setFlags(Request::SECURE);
-
-                req->taskId(blk->getTaskId());
+            if (!validBits[entryIndex])
+                continue;
 
-                // Create a new packet and set the address to the cache block address
-                PacketPtr wbPkt = new Packet(req, MemCmd::WritebackDirty);
-                wbPkt->setAddr(addr);
-
-                wbPkt->allocate();
-                wbPkt->setDataFromBlock(blk->data, blkSize);
+            for (unsigned int i = 0; i < numBlksInRegion; i++)
+            {
+                if (testDirtyBit(entryIndex, i) && !blkPtrs[entryIndex * numBlksInRegion + i])
+                {
+                    markBlkClean(entryIndex, i);
+                    numDropped++;
+                }
+            }
 
-                writebacks.push_back(wbPkt);
+            // Not counted in the DBI stats, the entry never existed in this simulation
+            if (entries[entryIndex].numDirtyBlks == 0)
+            {
+                validBits[entryIndex] = 0;
+                numValidEntries--;
+                generation++;
+                replacementPolicy->invalidate(entries[entryIndex].replacementData);
             }
         }
+        return numDropped;
     }
-
-    Addr
-    RDBI::regenerateBlkAddr(Addr regTag, unsigned int blkIndexInBitset)
-    {
-        return ((regTag << numblkIndexBits) | blkIndexInBitset) << numBlkBits;
-    }
-}
\ No newline at end of file
+}
@@ -2,123 +2,110 @@
 #define _MEM_CACHE_RDBI_RDBI_HH_
 
 #include <cstdint>
+#include <functional>
+#include <memory>
 #include <vector>
 
+#include "base/named.hh"
 #include "base/types.hh"
 #include "mem/packet.hh"
 #include "mem/cache/rdbi/rdbi_entry.hh"
+#include "mem/cache/rdbi/rdbi_store.hh"
 #include "mem/cache/dbi_cache_stats.hh"
 #include "mem/cache/dbi.hh"
 #include "mem/cache/cache.hh"
 #include "mem/cache/base.hh"
-#include "mem/cache/tags/base_set_assoc.hh"
-#include "mem/cache/tags/indexing_policies/set_associative.hh"
-#include "mem/cache/tags/sector_tags.hh"
+#include "mem/cache/replacement_policies/base.hh"
+#include "mem/cache/tags/indexing_policies/base.hh"
+#include "sim/serialize.hh"
 
 using namespace std;
 
 namespace gem5
 {
 
-    class RDBI
+    // The RDBI of a DBICache: the address-based store, plus the replacement and indexing policies,
+    // the DBI stats and the writeback packets of the cache
+    class RDBI : public RDBIStore, public Serializable, public Named
     {
 
     protected:
-        // RDBI store
-        vector<vector<RDBIEntry>> rDBIStore;
-
-        // Number of bits required to store the number of sets in RDBI
-        unsigned int numSetBits;
-        // Number of bits required to store the cache block size
-        unsigned int numBlkBits;
-        // Number of bits required to store the number of cache blocks per region(i.e., cache blocks per RDBI entry)
-        unsigned int numblkIndexBits;
-        // Associativity of the RDBI
-        unsigned int Assoc;
-        // Region address in the memory of the RDBI entry
-        unsigned int regAddr;
-        // Set index of the RDBI entry
-        unsigned int rDBIIndex;
-        // Number of cache blocks per region
-        unsigned int numBlksInRegion;
-        // Cache block index in the bitset
-        unsigned int blkIndexInBitset;
         // Cache block size
         unsigned int blkSize;
-        // Use aggressive writeback mechanism
-        bool useAggressiveWriteback;
-        // Value of bytes in block field
-        unsigned int bytesInBlock;
-        // Value of blocks inside region field
-        unsigned int blocksInRegion;
-        // Number of bits in the blocks in region field
-        unsigned int numBlocksInRegionBits;
-
-        // BaseCache::CacheStats &_stats;
+        // Replacement policy used to pick the RDBI entry to evict
+        replacement_policy::Base *replacementPolicy;
+        // Indexing policy used to find the candidate entries of a region
+        // If not set, the set is given by the low bits of the region tag
+        BaseIndexingPolicy *indexingPolicy;
+        // Storage for the candidate entries of a lookup, reused so that lookups do not allocate
+        mutable std::vector<ReplaceableEntry *> possibleEntries;
+
+        // Hooks of the store
+        int findEntry(const RDBILookup &dbiLookup) const override;
+        ReplacementCandidates getCandidates(const RDBILookup &dbiLookup) override;
+        int pickVictim(const ReplacementCandidates &candidates) override;
+        void entryEvicted(int entryIndex) override;
+        void entryInvalidated(int entryIndex, RDBIEvictionCause cause) override;
+        void regionWrittenBack(unsigned int numBlks) override;
+
+        // Synthetic write of the first block of the region of an entry, for the replacement policies
+        // that learn from the accesses (e.g., SHiP) when the RDBI is updated without a packet
+        std::unique_ptr<Packet> regionWritePacket(unsigned int entryIndex) const;
+
+        // Make the store callback that turns the written back blocks into writeback packets of the command
+        virtual WritebackFn
+        packetWriteback(PacketList &writebacks, MemCmd cmd) const
+        {
+            return [this, &writebacks, cmd](Addr addr, CacheBlk *blk, bool isRowBatch)
+            { writebacks.push_back(createWriteback(addr, blk, isRowBatch, cmd)); };
+        }
 
     public:
-        // Variable to store instance of a structure, overcoming the invalid type error
-        DBICacheStats *dbiCacheStats;
-
-        // DBICache object
-        DBICache *dbiCache;
-
-        // BaseSetAssoc *baseSetAssoc;
-
-        // SetAssociative *IndexingPolicy;
-
-        SectorTags *sectorTags;
-
-        Addr addr;
-
-        // Constructor
-        RDBI(unsigned int _numSetBits, unsigned int _numBlkBits, unsigned int _numblkIndexBits, unsigned int _assoc, unsigned int numBlksInRegion, unsigned int blkSize, bool _useAggressiveWriteback, DBICacheStats &dbistats, DBICache &dbiCache);
+        // Stats of the RDBI, the DBI stats of the cache or the stats of a SharedDBI
+        RDBIStats *rdbiStats;
 
-        // Get the cache block index from the bitset
-        unsigned int getblkIndexInBitset(PacketPtr pkt);
+        // Constructor, the name is the one of the cache or SharedDBI owning the RDBI
+        RDBI(unsigned int _numSetBits, unsigned int _numBlkBits, unsigned int _numblkIndexBits, unsigned int _assoc, unsigned int numBlksInRegion, unsigned int blkSize, bool _useAggressiveWriteback, replacement_policy::Base *_replacementPolicy, BaseIndexingPolicy *_indexingPolicy, RDBIStats &_rdbiStats, const std::string &_name);
 
-        // Fetch the bytes in block field
-        unsigned int getBytesInBlock(PacketPtr pkt);
-
-        // Fetch the blocks inside region field
-        unsigned int getBlocksInRegion(PacketPtr pkt);
-
-        // Get the region address of the RDBI entry
-        Addr getRegDBITag(PacketPtr pkt);
-
-        // Calculate the set index of the RDBI entry
-        int getRDBIEntryIndex(PacketPtr pkt);
-
-        // Return the DBIEntry if there is a regTag match
-        RDBIEntry *getRDBIEntry(PacketPtr pkt);
-
-        // Pick a replacement RDBI entry, by calling the RDBI replacement policy
-        RDBIEntry *pickRDBIEntry(vector<RDBIEntry> &rDBIEntries);
-
-        // Random replacement policy
-        RDBIEntry *randomReplacementPolicy(vector<RDBIEntry> &rDBIEntries);
+        // The address-based operations of the store stay available next to the packet-based ones
+        using RDBIStore::isDirty;
+        using RDBIStore::writebackRegion;
+        using RDBIStore::cleanRegion;
 
         // Check if the cache block is dirty
-        bool isDirty(PacketPtr pkt);
+        bool isDirty(PacketPtr pkt) const;
 
         // Clear the dirty bit of the cache block
-        void clearDirtyBit(PacketPtr pkt, PacketList &writebacks);
+        // The cause is recorded if the entry is invalidated without aggressive writeback
+        void clearDirtyBit(const RDBILookup &dbiLookup, PacketList &writebacks, RDBIEvictionCause cause);
+        void clearDirtyBit(PacketPtr pkt, PacketList &writebacks, RDBIEvictionCause cause);
 
         // Set the dirty bit of the cache block
+        // If the region is not tracked, a new entry is created and the handle is updated
+        void setDirtyBit(RDBILookup &dbiLookup, PacketPtr pkt, CacheBlk *blkPtr, PacketList &writebacks);
         void setDirtyBit(PacketPtr pkt, CacheBlk *blkPtr, PacketList &writebacks);
 
-        // Create a new RDBI entry
-        void createRDBIEntry(PacketList &writebacks, PacketPtr pkt, CacheBlk *blkPtr);
+        // Writeback the other dirty cache blocks of the region of the lookup
+        // The block of the lookup keeps its dirty bit, the others become clean
+        void writebackRegion(const RDBILookup &dbiLookup, PacketList &writebacks);
+
+        // Create the writeback packet of a dirty cache block
+        // WritebackDirty if the block leaves the cache, WriteClean if it stays in the cache as a clean block
+        PacketPtr createWriteback(Addr addr, CacheBlk *blk, bool isRowBatch, MemCmd cmd) const;
 
-        // Writeback the dirty cache blocks in the RDBI entry
-        void writebackRDBIEntry(PacketList &writebacks, RDBIEntry *rDBIEntry);
+        // Clean the least recently written region, writing back at most maxBlks of its dirty blocks
+        // The blocks stay in the cache, so they are written back with WriteClean packets
+        unsigned int cleanRegion(PacketList &writebacks, unsigned int maxBlks);
 
-        // evictDBIEntry function that takes PacketList and pointer to the rDBIEntries as arguments
-        void evictRDBIEntry(PacketList &writebacks, vector<RDBIEntry> &rDBIEntries);
+        // Checkpoint the region tags, valid bits and dirty bits of the entries
+        // The block pointers are not checkpointed, the cache sets them again as it restores its dirty blocks
+        void serialize(CheckpointOut &cp) const override;
+        void unserialize(CheckpointIn &cp) override;
 
-        // Re-generate the address
-        Addr regenerateBlkAddr(Addr regTag, unsigned int blkIndexInBitset);
+        // Drop the dirty bits of the restored entries whose block is not in the tag store
+        // Return the number of dirty bits dropped
+        unsigned int dropUnmappedBlks();
     };
 }
 
-#endif // _MEM_CACHE_RDBI_RDBI_HH_
\ No newline at end of file
+#endif // _MEM_CACHE_RDBI_RDBI_HH_
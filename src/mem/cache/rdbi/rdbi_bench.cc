@@ -0,0 +1,234 @@
+// Host throughput benchmark of the RDBI store
+//
+// Replays an address trace on an RDBIStore and reports the number of
+// operations per second. The trace is a text file with one operation per
+// line, an operation letter followed by a block address:
+//
+//     W <addr>    mark the block dirty
+//     C <addr>    clean the block, as a writeback of the cache does
+//     R <addr>    check the dirty bit of the block
+//
+// Addresses are read as hexadecimal, with or without a 0x prefix. Lines
+// starting with # are ignored. Without a trace, a synthetic trace of
+// region-clustered writes and reads is generated.
+//
+// With -c, every operation first checks the dirty bit of its block, as an
+// access of a DBICache does before it updates the block. This measures the
+// cost of the repeated lookups of an access.
+//
+// Usage: rdbi_bench [-s sets] [-a assoc] [-b blocks per region]
+//                   [-k block size] [-r repeat] [-n synthetic ops] [-c]
+//                   [trace]
+
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "base/intmath.hh"
+#include "base/types.hh"
+#include "mem/cache/rdbi/rdbi_store.hh"
+
+using namespace gem5;
+
+namespace
+{
+    enum class Op : uint8_t
+    {
+        Write,
+        Clean,
+        Read
+    };
+
+    struct TraceOp
+    {
+        Op op;
+        Addr addr;
+    };
+
+    bool
+    readTrace(const char *path, std::vector<TraceOp> &trace)
+    {
+        std::ifstream in(path);
+        if (!in)
+            return false;
+
+        std::string line;
+        while (std::getline(in, line))
+        {
+            if (line.empty() || line[0] == '#')
+                continue;
+
+            TraceOp traceOp;
+            switch (line[0])
+            {
+            case 'W':
+                traceOp.op = Op::Write;
+                break;
+            case 'C':
+                traceOp.op = Op::Clean;
+                break;
+            case 'R':
+                traceOp.op = Op::Read;
+                break;
+            default:
+                std::cerr << "Bad trace line: " << line << std::endl;
+                return false;
+            }
+            traceOp.addr = std::stoull(line.substr(1), nullptr, 16);
+            trace.push_back(traceOp);
+        }
+        return true;
+    }
+
+    // Visit random regions one after the other, writing a run of blocks in each and reading every written block,
+    // and clean blocks of earlier regions as a cache evicting dirty blocks would
+    void
+    makeTrace(std::vector<TraceOp> &trace, uint64_t numOps, unsigned int blkSize, unsigned int blksInRegion)
+    {
+        std::mt19937_64 rng(1);
+        const Addr regionSize = Addr(blkSize) * blksInRegion;
+        const Addr numRegions = 1 << 16;
+        std::vector<Addr> written;
+
+        while (trace.size() < numOps)
+        {
+            const Addr region = (rng() % numRegions) * regionSize;
+            const unsigned int first = rng() % blksInRegion;
+            const unsigned int run = 1 + rng() % blksInRegion;
+            for (unsigned int i = 0; i < run && trace.size() < numOps; i++)
+            {
+                const Addr addr = region + ((first + i) % blksInRegion) * blkSize;
+                trace.push_back({Op::Write, addr});
+                trace.push_back({Op::Read, addr});
+                written.push_back(addr);
+            }
+            while (written.size() > 4096)
+            {
+                const size_t victim = rng() % written.size();
+                trace.push_back({Op::Clean, written[victim]});
+                written[victim] = written.back();
+                written.pop_back();
+            }
+        }
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+    unsigned int numSets = 512;
+    unsigned int assoc = 4;
+    unsigned int blksInRegion = 64;
+    unsigned int blkSize = 64;
+    unsigned int repeat = 10;
+    uint64_t numOps = 1 << 22;
+    bool checkFirst = false;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "s:a:b:k:r:n:c")) != -1)
+    {
+        switch (opt)
+        {
+        case 's':
+            numSets = std::atoi(optarg);
+            break;
+        case 'a':
+            assoc = std::atoi(optarg);
+            break;
+        case 'b':
+            blksInRegion = std::atoi(optarg);
+            break;
+        case 'k':
+            blkSize = std::atoi(optarg);
+            break;
+        case 'r':
+            repeat = std::atoi(optarg);
+            break;
+        case 'n':
+            numOps = std::strtoull(optarg, nullptr, 10);
+            break;
+        case 'c':
+            checkFirst = true;
+            break;
+        default:
+            std::cerr << "Usage: " << argv[0] << " [-s sets] [-a assoc] [-b blocks per region] "
+                      << "[-k block size] [-r repeat] [-n synthetic ops] [-c] [trace]" << std::endl;
+            return 1;
+        }
+    }
+
+    if (!isPowerOf2(numSets) || !isPowerOf2(blksInRegion) || !isPowerOf2(blkSize) || assoc == 0)
+    {
+        std::cerr << "The sets, blocks per region and block size must be powers of 2" << std::endl;
+        return 1;
+    }
+
+    std::vector<TraceOp> trace;
+    if (optind < argc)
+    {
+        if (!readTrace(argv[optind], trace))
+        {
+            std::cerr << "Could not read the trace " << argv[optind] << std::endl;
+            return 1;
+        }
+    }
+    else
+    {
+        makeTrace(trace, numOps, blkSize, blksInRegion);
+    }
+
+    RDBIStore store(numSets, floorLog2(blkSize), floorLog2(blksInRegion), assoc, blksInRegion, false);
+    uint64_t numWritebacks = 0;
+    uint64_t numDirtyReads = 0;
+    const RDBIStore::WritebackFn writeback = [&numWritebacks](Addr, CacheBlk *, bool)
+    { numWritebacks++; };
+
+    // The store never dereferences the cache blocks
+    CacheBlk *const blk = reinterpret_cast<CacheBlk *>(uintptr_t(1));
+
+    // Every write gets its own tick, so that the least recently written region is well defined
+    Tick tick = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (unsigned int r = 0; r < repeat; r++)
+    {
+        for (const TraceOp &traceOp : trace)
+        {
+            if (checkFirst)
+                numDirtyReads += store.isDirty(traceOp.addr);
+
+            switch (traceOp.op)
+            {
+            case Op::Write:
+                store.markDirty(traceOp.addr, blk, ++tick, writeback);
+                break;
+            case Op::Clean:
+                store.clearDirty(traceOp.addr, RDBIWriteback, writeback);
+                break;
+            case Op::Read:
+                numDirtyReads += store.isDirty(traceOp.addr);
+                break;
+            }
+        }
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    const double totalOps = double(trace.size()) * repeat;
+    std::cout << "RDBI of " << numSets << " sets x " << assoc << " ways, "
+              << blksInRegion << " blocks of " << blkSize << " bytes per region"
+              << (checkFirst ? ", dirty check before each operation" : "") << std::endl;
+    std::cout << "Replayed " << trace.size() << " operations " << repeat << " times in "
+              << elapsed.count() << " s" << std::endl;
+    std::cout << "Throughput: " << totalOps / elapsed.count() / 1e6 << " Mops/s, "
+              << elapsed.count() * 1e9 / totalOps << " ns/op" << std::endl;
+    std::cout << "Writebacks: " << numWritebacks << ", dirty reads: " << numDirtyReads
+              << ", valid entries at the end: " << store.numValid() << std::endl;
+
+    return 0;
+}
@@ -1,32 +1,61 @@
 #ifndef _MEM_CACHE_REGION_DBI_RDBI_ENTRY_HH_
 #define _MEM_CACHE_REGION_DBI_RDBI_ENTRY_HH_
 
-#include <bitset>
 #include <cstdint>
+#include <string>
 
+#include "base/cprintf.hh"
 #include "base/types.hh"
-#include "mem/cache/cache_blk.hh"
+#include "mem/cache/replacement_policies/replaceable_entry.hh"
 
 using namespace std;
 
 namespace gem5
 {
-    class RDBIEntry
+    // Reasons for which an RDBI entry is invalidated
+    enum RDBIEvictionCause
+    {
+        // Another region needed the entry
+        RDBICapacity,
+        // The region was written back by the aggressive writeback mechanism
+        RDBIAggressiveWriteback,
+        // The last dirty block of the region was written back or invalidated by the cache
+        RDBIWriteback,
+        // The last dirty block of the region was passed on to a cache above, with its ownership
+        RDBITransfer,
+        // The last dirty block of the region was passed on or invalidated by a snoop
+        RDBISnoop,
+        // The region was written back by a flush of the cache
+        RDBIFlush,
+        // The region was cleaned by the idle-time writeback engine
+        RDBIIdleWriteback,
+        NumRDBIEvictionCauses
+    };
+
+    // An RDBI entry is a replaceable entry, so that the RDBI can use any of the replacement policies
+    // The region tags, dirty bits and block pointers of the entries live in the RDBI's flat arrays
+    class RDBIEntry : public ReplaceableEntry
     {
     public:
-        int validBit;
-        Addr regTag;
-        bitset<128> dirtyBits;
-        vector<CacheBlk *> blkPtrs;
+        // Number of dirty blocks of the region tracked by the entry
+        unsigned int numDirtyBlks;
+        // Last time a block of the region was written
+        Tick lastWriteTick;
+
+        RDBIEntry()
+        {
+            numDirtyBlks = 0;
+            lastWriteTick = 0;
+        }
 
-        RDBIEntry(int numBlksPerRegion)
+        // Print the number of dirty blocks of the entry
+        std::string
+        print() const override
         {
-            validBit = 0;
-            regTag = 0;
-            dirtyBits = bitset<128>(0);
-            blkPtrs = vector<CacheBlk *>(numBlksPerRegion, nullptr);
+            return csprintf("dirty blocks: %d %s", numDirtyBlks,
+                            ReplaceableEntry::print());
         }
     };
 }
 
-#endif // _MEM_CACHE_REGION_DBI_RDBI_ENTRY_HH_
\ No newline at end of file
+#endif // _MEM_CACHE_REGION_DBI_RDBI_ENTRY_HH_
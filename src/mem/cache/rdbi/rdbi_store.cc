@@ -0,0 +1,430 @@
+#include "mem/cache/rdbi/rdbi_store.hh"
+
+#include <algorithm>
+#include <cassert>
+
+#include "base/bitfield.hh"
+#include "base/intmath.hh"
+
+using namespace std;
+
+namespace gem5
+{
+
+    RDBIStore::RDBIStore(unsigned int _numSets, unsigned int _numBlkBits, unsigned int _numblkIndexBits, unsigned int _assoc, unsigned int _numBlksInRegion, bool _useAggressiveWriteback)
+    {
+        numSets = _numSets;
+        numSetBits = floorLog2(_numSets);
+        numBlkBits = _numBlkBits;
+        // Bits required to index into DBI entries
+        numblkIndexBits = _numblkIndexBits;
+        Assoc = _assoc;
+        numBlksInRegion = _numBlksInRegion;
+        // One dirty bit per block of the region, packed in 64-bit words
+        wordsPerEntry = divCeil(numBlksInRegion, 64);
+        useAggressiveWriteback = _useAggressiveWriteback;
+
+        // Allocate the flat arrays of the RDBI store
+        unsigned int numEntries = numSets * Assoc;
+        regTags = vector<Addr>(numEntries, 0);
+        validBits = vector<uint8_t>(numEntries, 0);
+        dirtyWords = vector<uint64_t>(numEntries * wordsPerEntry, 0);
+        blkPtrs = vector<CacheBlk *>(numEntries * numBlksInRegion, nullptr);
+        entries = vector<RDBIEntry>(numEntries);
+
+        // Link every entry to its set and way
+        for (unsigned int set = 0; set < numSets; set++)
+        {
+            for (unsigned int way = 0; way < Assoc; way++)
+            {
+                entries[set * Assoc + way].setPosition(set, way);
+            }
+        }
+
+        numValidEntries = 0;
+        generation = 1;
+        lastLookupGeneration = 0;
+    }
+
+    unsigned int
+    RDBIStore::getblkIndexInBitset(Addr addr) const
+    {
+        // Remove the bytes in block field and keep the blocks in region field
+        return (addr >> numBlkBits) & ((1 << numblkIndexBits) - 1);
+    }
+
+    Addr
+    RDBIStore::getRegDBITag(Addr addr) const
+    {
+        return addr >> (numBlkBits + numblkIndexBits);
+    }
+
+    unsigned int
+    RDBIStore::getRDBIEntryIndex(Addr regTag) const
+    {
+        // Use the low numSetBits bits of the region tag to index into the RDBI
+        return regTag & ((1 << numSetBits) - 1);
+    }
+
+    Addr
+    RDBIStore::regenerateBlkAddr(Addr regTag, unsigned int blkIndexInBitset) const
+    {
+        return ((regTag << numblkIndexBits) | blkIndexInBitset) << numBlkBits;
+    }
+
+    RDBILookup
+    RDBIStore::lookup(Addr addr) const
+    {
+        // Reuse the last lookup if it was for the same region and no entry was inserted or invalidated since
+        const Addr regTag = getRegDBITag(addr);
+        if (lastLookupGeneration != generation || lastLookup.regTag != regTag)
+        {
+            lastLookup = search(addr);
+            lastLookupGeneration = generation;
+        }
+
+        RDBILookup dbiLookup = lastLookup;
+        dbiLookup.blkIndex = getblkIndexInBitset(addr);
+        return dbiLookup;
+    }
+
+    RDBILookup
+    RDBIStore::search(Addr addr) const
+    {
+        RDBILookup dbiLookup;
+        dbiLookup.regTag = getRegDBITag(addr);
+        dbiLookup.set = getRDBIEntryIndex(dbiLookup.regTag);
+        dbiLookup.blkIndex = getblkIndexInBitset(addr);
+        dbiLookup.entryIndex = findEntry(dbiLookup);
+        return dbiLookup;
+    }
+
+    int
+    RDBIStore::findEntry(const RDBILookup &dbiLookup) const
+    {
+        // Search the contiguous tags of the set for a valid entry of the region
+        const unsigned int first = dbiLookup.set * Assoc;
+        for (unsigned int i = first; i < first + Assoc; i++)
+        {
+            if (validBits[i] && regTags[i] == dbiLookup.regTag)
+                return i;
+        }
+        return -1;
+    }
+
+    ReplacementCandidates
+    RDBIStore::getCandidates(const RDBILookup &dbiLookup)
+    {
+        // All the entries of the set are candidates
+        ReplacementCandidates candidates;
+        candidates.reserve(Assoc);
+        for (unsigned int i = dbiLookup.set * Assoc; i < (dbiLookup.set + 1) * Assoc; i++)
+        {
+            candidates.push_back(&entries[i]);
+        }
+        return candidates;
+    }
+
+    int
+    RDBIStore::pickVictim(const ReplacementCandidates &candidates)
+    {
+        // Evict the region written the longest time ago
+        int victim = getEntryIndex(candidates[0]);
+        for (const auto &candidate : candidates)
+        {
+            const int i = getEntryIndex(candidate);
+            if (entries[i].lastWriteTick < entries[victim].lastWriteTick)
+                victim = i;
+        }
+        return victim;
+    }
+
+    bool
+    RDBIStore::isDirty(const RDBILookup &dbiLookup) const
+    {
+        // If a valid RDBI entry is not found, the block is clean
+        return dbiLookup.hit() && testDirtyBit(dbiLookup.entryIndex, dbiLookup.blkIndex);
+    }
+
+    void
+    RDBIStore::clearDirtyBits(int entryIndex)
+    {
+        fill_n(dirtyWords.begin() + entryIndex * wordsPerEntry, wordsPerEntry, 0);
+        entries[entryIndex].numDirtyBlks = 0;
+    }
+
+    void
+    RDBIStore::markDirty(RDBILookup &dbiLookup, CacheBlk *blkPtr, Tick when, const WritebackFn &writeback)
+    {
+        // If a valid RDBI entry is not found, create a new entry
+        if (!dbiLookup.hit())
+        {
+            createRDBIEntry(dbiLookup, writeback);
+        }
+
+        const int entryIndex = dbiLookup.entryIndex;
+        const unsigned int blkIndex = dbiLookup.blkIndex;
+
+        // Set the dirty bit from the bitset
+        if (!testDirtyBit(entryIndex, blkIndex))
+        {
+            markBlkDirty(entryIndex, blkIndex);
+        }
+
+        // Store the block pointer
+        blkPtrs[entryIndex * numBlksInRegion + blkIndex] = blkPtr;
+        entries[entryIndex].lastWriteTick = when;
+    }
+
+    void
+    RDBIStore::markDirty(Addr addr, CacheBlk *blkPtr, Tick when, const WritebackFn &writeback)
+    {
+        RDBILookup dbiLookup = lookup(addr);
+        markDirty(dbiLookup, blkPtr, when, writeback);
+    }
+
+    void
+    RDBIStore::clearDirty(const RDBILookup &dbiLookup, RDBIEvictionCause cause, const WritebackFn &writeback)
+    {
+        // Check if a valid RDBI entry is found
+        if (!dbiLookup.hit())
+            return;
+
+        const int entryIndex = dbiLookup.entryIndex;
+
+        // If the useAggressiveWriteback flag is set, writeback the entire region
+        // Then clear the dirty bits from the bitset
+        if (useAggressiveWriteback)
+        {
+            writebackRDBIEntry(entryIndex, writeback);
+            clearDirtyBits(entryIndex);
+        }
+
+        // Else, clear the dirty bit from the bitset
+        else if (testDirtyBit(entryIndex, dbiLookup.blkIndex))
+        {
+            markBlkClean(entryIndex, dbiLookup.blkIndex);
+        }
+
+        // Invalidate the RDBI entry if no block of the region is dirty anymore
+        if (entries[entryIndex].numDirtyBlks == 0)
+            invalidateRDBIEntry(entryIndex, useAggressiveWriteback ? RDBIAggressiveWriteback : cause);
+    }
+
+    void
+    RDBIStore::clearDirty(Addr addr, RDBIEvictionCause cause, const WritebackFn &writeback)
+    {
+        clearDirty(lookup(addr), cause, writeback);
+    }
+
+    void
+    RDBIStore::invalidateBlk(const RDBILookup &dbiLookup, RDBIEvictionCause cause)
+    {
+        // Check if a valid RDBI entry is found
+        if (!dbiLookup.hit())
+            return;
+
+        const int entryIndex = dbiLookup.entryIndex;
+        const unsigned int blkIndex = dbiLookup.blkIndex;
+
+        // Clear the dirty bit and the block pointer, so that no writeback is generated for the block
+        if (testDirtyBit(entryIndex, blkIndex))
+        {
+            markBlkClean(entryIndex, blkIndex);
+        }
+        blkPtrs[entryIndex * numBlksInRegion + blkIndex] = nullptr;
+
+        // Invalidate the RDBI entry if no block of the region is dirty anymore
+        if (entries[entryIndex].numDirtyBlks == 0)
+            invalidateRDBIEntry(entryIndex, cause);
+    }
+
+    void
+    RDBIStore::writebackRegion(const RDBILookup &dbiLookup, const WritebackFn &writeback)
+    {
+        // Check if a valid RDBI entry is found
+        if (!dbiLookup.hit())
+            return;
+
+        const int entryIndex = dbiLookup.entryIndex;
+        const unsigned int blkIndex = dbiLookup.blkIndex;
+
+        // Leave the block of the lookup out of the writebacks, its owner writes it back
+        const bool blkDirty = testDirtyBit(entryIndex, blkIndex);
+        if (blkDirty)
+            markBlkClean(entryIndex, blkIndex);
+
+        writebackRDBIEntry(entryIndex, writeback);
+        clearDirtyBits(entryIndex);
+
+        // Keep tracking the block of the lookup, or drop the entry if it was clean
+        if (blkDirty)
+            markBlkDirty(entryIndex, blkIndex);
+        else
+            invalidateRDBIEntry(entryIndex, RDBIAggressiveWriteback);
+    }
+
+    void
+    RDBIStore::createRDBIEntry(RDBILookup &dbiLookup, const WritebackFn &writeback)
+    {
+        const ReplacementCandidates candidates = getCandidates(dbiLookup);
+
+        // Look for an invalid entry among the candidates
+        // If no invalid entry is found, evict an entry
+        int entryIndex = -1;
+        for (const auto &candidate : candidates)
+        {
+            if (!validBits[getEntryIndex(candidate)])
+            {
+                entryIndex = getEntryIndex(candidate);
+                break;
+            }
+        }
+
+        if (entryIndex < 0)
+        {
+            entryIndex = pickVictim(candidates);
+            entryEvicted(entryIndex);
+
+            // Generate writebacks for all the dirty cache blocks in the region
+            // Invalidate the RDBIEntry
+            writebackRDBIEntry(entryIndex, writeback);
+            clearDirtyBits(entryIndex);
+            invalidateRDBIEntry(entryIndex, RDBICapacity);
+        }
+
+        // Create a new entry, its dirty bits were cleared when it was invalidated
+        regTags[entryIndex] = dbiLookup.regTag;
+        validBits[entryIndex] = 1;
+        numValidEntries++;
+        generation++;
+
+        dbiLookup.entryIndex = entryIndex;
+    }
+
+    void
+    RDBIStore::invalidateRDBIEntry(int entryIndex, RDBIEvictionCause cause)
+    {
+        assert(entries[entryIndex].numDirtyBlks == 0);
+        assert(validBits[entryIndex]);
+
+        numValidEntries--;
+        generation++;
+
+        // Drop the block pointers of the region, they may be stale once the blocks leave the cache
+        fill_n(blkPtrs.begin() + entryIndex * numBlksInRegion, numBlksInRegion, nullptr);
+        validBits[entryIndex] = 0;
+        entryInvalidated(entryIndex, cause);
+    }
+
+    void
+    RDBIStore::writebackRDBIEntry(int entryIndex, const WritebackFn &writeback)
+    {
+        // Iterate over the dirty bit words of the RDBI entry and visit every dirty bit that is set
+        // For every dirty bit, fetch the corresponding cache block pointer from the blkPtrs field
+        // Re-generate the cache block address from the region tag and pass the block on to the callback
+        // If more than one block of the region is dirty, tag the writebacks as a row batch
+        // so that the memory controller drains them back-to-back in the open row
+        const unsigned int numDirtyBlks = entries[entryIndex].numDirtyBlks;
+        if (numDirtyBlks == 0)
+            return;
+
+        const bool isRowBatch = numDirtyBlks > 1;
+        regionWrittenBack(numDirtyBlks);
+        const uint64_t *words = &dirtyWords[entryIndex * wordsPerEntry];
+
+        for (unsigned int w = 0; w < wordsPerEntry; w++)
+        {
+            uint64_t word = words[w];
+            while (word)
+            {
+                unsigned int i = w * 64 + ctz64(word);
+                word &= word - 1;
+
+                writeback(regenerateBlkAddr(regTags[entryIndex], i), blkPtrs[entryIndex * numBlksInRegion + i], isRowBatch);
+            }
+        }
+    }
+
+    unsigned int
+    RDBIStore::cleanRegion(unsigned int maxBlks, const WritebackFn &writeback)
+    {
+        if (numValidEntries == 0)
+            return 0;
+
+        // Pick the region written the longest time ago
+        // The replacement policy is not used, as its victim is only meaningful within a set
+        int entryIndex = -1;
+        for (unsigned int i = 0; i < entries.size(); i++)
+        {
+            if (validBits[i] && (entryIndex < 0 || entries[i].lastWriteTick < entries[entryIndex].lastWriteTick))
+                entryIndex = i;
+        }
+
+        // Write back up to maxBlks dirty blocks, the others are left for the next cleaning
+        const unsigned int numBlks = std::min(maxBlks, entries[entryIndex].numDirtyBlks);
+        const bool isRowBatch = numBlks > 1;
+        regionWrittenBack(numBlks);
+
+        unsigned int numWritebacks = 0;
+        for (unsigned int w = 0; w < wordsPerEntry && numWritebacks < numBlks; w++)
+        {
+            uint64_t word = dirtyWords[entryIndex * wordsPerEntry + w];
+            while (word && numWritebacks < numBlks)
+            {
+                unsigned int i = w * 64 + ctz64(word);
+                word &= word - 1;
+
+                writeback(regenerateBlkAddr(regTags[entryIndex], i), blkPtrs[entryIndex * numBlksInRegion + i], isRowBatch);
+                markBlkClean(entryIndex, i);
+                numWritebacks++;
+            }
+        }
+
+        // Invalidate the RDBI entry once the whole region is clean
+        if (entries[entryIndex].numDirtyBlks == 0)
+            invalidateRDBIEntry(entryIndex, RDBIIdleWriteback);
+
+        return numBlks;
+    }
+
+    bool
+    RDBIStore::anyDirty() const
+    {
+        // An entry is invalidated as soon as its last dirty block is cleaned, so every valid entry has a dirty block
+        return numValidEntries > 0;
+    }
+
+    void
+    RDBIStore::forEachDirtyBlk(std::function<void(CacheBlk &)> visitor) const
+    {
+        for (unsigned int entryIndex = 0; entryIndex < entries.size(); entryIndex++)
+        {
+            if (!validBits[entryIndex])
+                continue;
+
+            // Visit the dirty blocks in address order
+            // The words are copied, since the visitor may clear the dirty bits of the entry
+            for (unsigned int w = 0; w < wordsPerEntry; w++)
+            {
+                uint64_t word = dirtyWords[entryIndex * wordsPerEntry + w];
+                while (word)
+                {
+                    unsigned int i = w * 64 + ctz64(word);
+                    word &= word - 1;
+                    visitor(*blkPtrs[entryIndex * numBlksInRegion + i]);
+                }
+            }
+        }
+    }
+
+    bool
+    RDBIStore::restoreBlkPtr(const RDBILookup &dbiLookup, CacheBlk *blkPtr)
+    {
+        if (!dbiLookup.hit() || !testDirtyBit(dbiLookup.entryIndex, dbiLookup.blkIndex))
+            return false;
+
+        blkPtrs[dbiLookup.entryIndex * numBlksInRegion + dbiLookup.blkIndex] = blkPtr;
+        return true;
+    }
+}
@@ -0,0 +1,220 @@
+#ifndef _MEM_CACHE_RDBI_RDBI_STORE_HH_
+#define _MEM_CACHE_RDBI_RDBI_STORE_HH_
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "base/types.hh"
+#include "mem/cache/rdbi/rdbi_entry.hh"
+#include "mem/cache/replacement_policies/replaceable_entry.hh"
+
+using namespace std;
+
+namespace gem5
+{
+    class CacheBlk;
+
+    // Same as the candidates of the replacement policies, declared here so that the store does not depend on their SimObject
+    typedef std::vector<ReplaceableEntry *> ReplacementCandidates;
+
+    // The result of a single RDBI lookup
+    // A DBICache looks up the RDBI once per access and reuses the handle for the dirty bit operations
+    // The handle is only valid until another region is inserted in or removed from the RDBI
+    struct RDBILookup
+    {
+        // Index of the RDBI entry in the flat arrays, or -1 if the region is not tracked
+        int entryIndex;
+        // Set index of the region, when the RDBI has no indexing policy
+        unsigned int set;
+        // Region tag of the region
+        Addr regTag;
+        // Cache block index in the region
+        unsigned int blkIndex;
+
+        // Check if the region is tracked by the RDBI
+        bool hit() const { return entryIndex >= 0; }
+    };
+
+    // Address-based store of the RDBI: the region tags, dirty bits and block pointers of the entries
+    // It knows nothing about packets, stats or SimObjects, so it can be unit tested and benchmarked on its own
+    // The cache blocks are opaque to the store, it only hands them back to the writeback callback
+    class RDBIStore
+    {
+    public:
+        // Called for every dirty block the store writes back, with its address, its cache block,
+        // and whether the blocks of the region are drained as a row batch
+        using WritebackFn = std::function<void(Addr, CacheBlk *, bool)>;
+
+    protected:
+        // RDBI store, kept as a structure of arrays
+        // Entry e of set s is at index (s * Assoc + e) of every array
+
+        // Region tags of the RDBI entries, contiguous per set
+        vector<Addr> regTags;
+        // Valid bits of the RDBI entries
+        vector<uint8_t> validBits;
+        // Dirty bits of the RDBI entries, wordsPerEntry words per entry
+        vector<uint64_t> dirtyWords;
+        // Cache block pointers of the RDBI entries, numBlksInRegion pointers per entry
+        vector<CacheBlk *> blkPtrs;
+        // Replaceable entries, used by the replacement policy
+        vector<RDBIEntry> entries;
+
+        // Number of sets in RDBI
+        unsigned int numSets;
+        // Number of bits required to store the number of sets in RDBI
+        unsigned int numSetBits;
+        // Number of bits required to store the cache block size
+        unsigned int numBlkBits;
+        // Number of bits required to store the number of cache blocks per region(i.e., cache blocks per RDBI entry)
+        unsigned int numblkIndexBits;
+        // Associativity of the RDBI
+        unsigned int Assoc;
+        // Number of cache blocks per region
+        unsigned int numBlksInRegion;
+        // Number of 64-bit dirty bit words per RDBI entry
+        unsigned int wordsPerEntry;
+        // Number of valid RDBI entries
+        unsigned int numValidEntries;
+        // Write back the whole region whenever one of its blocks is cleaned
+        bool useAggressiveWriteback;
+
+        // Bumped whenever an entry is inserted or invalidated, i.e., whenever a lookup may change
+        uint64_t generation;
+        // Last lookup and the generation it was made in
+        // An access checks and updates the dirty bit of its block several times, only the first check searches the RDBI
+        mutable RDBILookup lastLookup;
+        mutable uint64_t lastLookupGeneration;
+
+        // Search the RDBI for the region of an address
+        RDBILookup search(Addr addr) const;
+
+        // Get the index of an entry in the flat arrays
+        int
+        getEntryIndex(const ReplaceableEntry *entry) const
+        {
+            return entry->getSet() * Assoc + entry->getWay();
+        }
+
+        // Check the dirty bit of a block of an entry
+        bool
+        testDirtyBit(int entryIndex, unsigned int blkIndex) const
+        {
+            return (dirtyWords[entryIndex * wordsPerEntry + blkIndex / 64] >> (blkIndex % 64)) & 1;
+        }
+
+        // Set the dirty bit of a clean block of an entry
+        void
+        markBlkDirty(int entryIndex, unsigned int blkIndex)
+        {
+            dirtyWords[entryIndex * wordsPerEntry + blkIndex / 64] |= uint64_t(1) << (blkIndex % 64);
+            entries[entryIndex].numDirtyBlks++;
+        }
+
+        // Clear the dirty bit of a dirty block of an entry
+        void
+        markBlkClean(int entryIndex, unsigned int blkIndex)
+        {
+            dirtyWords[entryIndex * wordsPerEntry + blkIndex / 64] &= ~(uint64_t(1) << (blkIndex % 64));
+            entries[entryIndex].numDirtyBlks--;
+        }
+
+        // Clear all the dirty bits of an entry
+        void clearDirtyBits(int entryIndex);
+
+        // Create a new RDBI entry for the region of the lookup, evicting an entry if needed
+        void createRDBIEntry(RDBILookup &dbiLookup, const WritebackFn &writeback);
+
+        // Invalidate the RDBI entry, its dirty bits must be cleared
+        void invalidateRDBIEntry(int entryIndex, RDBIEvictionCause cause);
+
+        // Write back the dirty cache blocks of the RDBI entry, its dirty bits are left set
+        void writebackRDBIEntry(int entryIndex, const WritebackFn &writeback);
+
+        // Hooks of the RDBI built on the store
+        // By default the set is given by the low bits of the region tag, and the least recently written entry is evicted
+
+        // Find the valid entry of the region of the lookup, -1 if the region is not tracked
+        virtual int findEntry(const RDBILookup &dbiLookup) const;
+        // Get the entries where the region of the lookup can be placed
+        virtual ReplacementCandidates getCandidates(const RDBILookup &dbiLookup);
+        // Pick the entry to evict among the candidates, all of them valid
+        virtual int pickVictim(const ReplacementCandidates &candidates);
+        // Called before a valid entry is evicted for another region
+        virtual void entryEvicted(int entryIndex) {}
+        // Called once an entry is invalidated
+        virtual void entryInvalidated(int entryIndex, RDBIEvictionCause cause) {}
+        // Called when numBlks dirty blocks of a region are written back together
+        virtual void regionWrittenBack(unsigned int numBlks) {}
+
+    public:
+        RDBIStore(unsigned int _numSets, unsigned int _numBlkBits, unsigned int _numblkIndexBits, unsigned int _assoc, unsigned int _numBlksInRegion, bool _useAggressiveWriteback);
+        virtual ~RDBIStore() = default;
+
+        // Get the cache block index in the region
+        unsigned int getblkIndexInBitset(Addr addr) const;
+
+        // Get the region address of the RDBI entry
+        Addr getRegDBITag(Addr addr) const;
+
+        // Calculate the set index of the RDBI entry
+        unsigned int getRDBIEntryIndex(Addr regTag) const;
+
+        // Re-generate the address
+        Addr regenerateBlkAddr(Addr regTag, unsigned int blkIndexInBitset) const;
+
+        // Look up the RDBI entry of the region containing the address
+        RDBILookup lookup(Addr addr) const;
+
+        // Check if the cache block is dirty
+        bool isDirty(const RDBILookup &dbiLookup) const;
+        bool isDirty(Addr addr) const { return isDirty(lookup(addr)); }
+
+        // Number of dirty blocks of the region of the lookup, 0 if the region is not tracked
+        unsigned int
+        numDirtyBlks(const RDBILookup &dbiLookup) const
+        {
+            return dbiLookup.hit() ? entries[dbiLookup.entryIndex].numDirtyBlks : 0;
+        }
+
+        // Set the dirty bit of the cache block, written at tick when
+        // If the region is not tracked, a new entry is created and the handle is updated
+        // The dirty blocks of an evicted region are passed to the writeback callback
+        void markDirty(RDBILookup &dbiLookup, CacheBlk *blkPtr, Tick when, const WritebackFn &writeback);
+        void markDirty(Addr addr, CacheBlk *blkPtr, Tick when, const WritebackFn &writeback);
+
+        // Clear the dirty bit of the cache block
+        // The cause is recorded if the entry is invalidated without aggressive writeback
+        void clearDirty(const RDBILookup &dbiLookup, RDBIEvictionCause cause, const WritebackFn &writeback);
+        void clearDirty(Addr addr, RDBIEvictionCause cause, const WritebackFn &writeback);
+
+        // Forget a cache block that is clean or leaves the tag store
+        // Its dirty bit and block pointer are cleared, and the RDBI entry is invalidated once no block of the region is dirty
+        void invalidateBlk(const RDBILookup &dbiLookup, RDBIEvictionCause cause);
+
+        // Writeback the other dirty cache blocks of the region of the lookup
+        // The block of the lookup keeps its dirty bit, the others become clean
+        void writebackRegion(const RDBILookup &dbiLookup, const WritebackFn &writeback);
+
+        // Clean the least recently written region, writing back at most maxBlks of its dirty blocks
+        // The blocks stay in the cache as clean blocks, and the entry is invalidated once the region is clean
+        // Return the number of blocks written back, 0 if no region is tracked
+        unsigned int cleanRegion(unsigned int maxBlks, const WritebackFn &writeback);
+
+        // Check if any block tracked by the RDBI is dirty
+        bool anyDirty() const;
+
+        // Number of valid RDBI entries
+        unsigned int numValid() const { return numValidEntries; }
+
+        // Visit the dirty cache blocks of every valid RDBI entry, region by region
+        // The visitor may clear the dirty bit of the visited block
+        void forEachDirtyBlk(std::function<void(CacheBlk &)> visitor) const;
+
+        // Set the block pointer of a restored dirty block, return false if the RDBI does not track it as dirty
+        bool restoreBlkPtr(const RDBILookup &dbiLookup, CacheBlk *blkPtr);
+    };
+}
+
+#endif // _MEM_CACHE_RDBI_RDBI_STORE_HH_
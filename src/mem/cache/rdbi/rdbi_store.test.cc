@@ -0,0 +1,284 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+#include "mem/cache/rdbi/rdbi_store.hh"
+
+using namespace gem5;
+
+namespace
+{
+    // 64-byte blocks, 16 blocks per region, so the regions are 1KB
+    const unsigned int blkBits = 6;
+    const unsigned int blkIndexBits = 4;
+    const unsigned int blksInRegion = 1 << blkIndexBits;
+    const Addr regionSize = Addr(1) << (blkBits + blkIndexBits);
+
+    // The store never dereferences the cache blocks, so the tests use fake pointers
+    CacheBlk *
+    fakeBlk(Addr addr)
+    {
+        return reinterpret_cast<CacheBlk *>(uintptr_t(addr) | 1);
+    }
+
+    // Record the blocks written back by the store
+    struct Writebacks
+    {
+        std::vector<std::tuple<Addr, CacheBlk *, bool>> blks;
+
+        RDBIStore::WritebackFn
+        fn()
+        {
+            return [this](Addr addr, CacheBlk *blk, bool isRowBatch)
+            { blks.emplace_back(addr, blk, isRowBatch); };
+        }
+    };
+
+    // Address of a block of a region that maps to the given set of a store with numSets sets
+    Addr
+    blkAddr(unsigned int numSets, unsigned int set, unsigned int tag, unsigned int blk)
+    {
+        return ((Addr(tag) * numSets + set) * regionSize) + blk * (Addr(1) << blkBits);
+    }
+}
+
+// The region tag, block index and block address of the store are consistent
+TEST(RDBIStoreTest, Geometry)
+{
+    RDBIStore store(4, blkBits, blkIndexBits, 2, blksInRegion, false);
+
+    const Addr addr = blkAddr(4, 3, 5, 7);
+    const Addr regTag = store.getRegDBITag(addr);
+    ASSERT_EQ(regTag, 5 * 4 + 3);
+    ASSERT_EQ(store.getRDBIEntryIndex(regTag), 3);
+    ASSERT_EQ(store.getblkIndexInBitset(addr), 7);
+    ASSERT_EQ(store.regenerateBlkAddr(regTag, 7), addr);
+    // The bytes in the block do not matter
+    ASSERT_EQ(store.getblkIndexInBitset(addr + 63), 7);
+}
+
+// A block is dirty from markDirty until clearDirty, and the other blocks of its region stay clean
+TEST(RDBIStoreTest, MarkAndClearDirty)
+{
+    RDBIStore store(4, blkBits, blkIndexBits, 2, blksInRegion, false);
+    Writebacks wbs;
+
+    const Addr addr = blkAddr(4, 1, 2, 3);
+    ASSERT_FALSE(store.isDirty(addr));
+    ASSERT_FALSE(store.lookup(addr).hit());
+    ASSERT_FALSE(store.anyDirty());
+
+    store.markDirty(addr, fakeBlk(addr), 10, wbs.fn());
+    ASSERT_TRUE(store.lookup(addr).hit());
+    ASSERT_TRUE(store.isDirty(addr));
+    ASSERT_FALSE(store.isDirty(addr + (Addr(1) << blkBits)));
+    ASSERT_TRUE(store.anyDirty());
+    ASSERT_EQ(store.numValid(), 1);
+
+    // Marking the block again does not count it twice
+    store.markDirty(addr, fakeBlk(addr), 20, wbs.fn());
+    store.clearDirty(addr, RDBIWriteback, wbs.fn());
+    ASSERT_FALSE(store.isDirty(addr));
+    ASSERT_FALSE(store.lookup(addr).hit());
+    ASSERT_FALSE(store.anyDirty());
+    ASSERT_EQ(store.numValid(), 0);
+    ASSERT_TRUE(wbs.blks.empty());
+}
+
+// The entry of a region is only invalidated once its last dirty block is cleaned
+TEST(RDBIStoreTest, EntryLivesWhileRegionDirty)
+{
+    RDBIStore store(4, blkBits, blkIndexBits, 2, blksInRegion, false);
+    Writebacks wbs;
+
+    const Addr a = blkAddr(4, 0, 1, 0);
+    const Addr b = blkAddr(4, 0, 1, 15);
+    store.markDirty(a, fakeBlk(a), 1, wbs.fn());
+    store.markDirty(b, fakeBlk(b), 2, wbs.fn());
+    ASSERT_EQ(store.numValid(), 1);
+    ASSERT_EQ(store.numDirtyBlks(store.lookup(a)), 2);
+
+    store.clearDirty(a, RDBIWriteback, wbs.fn());
+    ASSERT_TRUE(store.lookup(b).hit());
+    ASSERT_TRUE(store.isDirty(b));
+    ASSERT_EQ(store.numDirtyBlks(store.lookup(a)), 1);
+
+    // Invalidating a block drops its dirty bit without a writeback
+    store.invalidateBlk(store.lookup(b), RDBIWriteback);
+    ASSERT_FALSE(store.anyDirty());
+    ASSERT_EQ(store.numDirtyBlks(store.lookup(b)), 0);
+    ASSERT_TRUE(wbs.blks.empty());
+}
+
+// Inserting a region in a full set evicts the least recently written region and writes back its dirty blocks
+TEST(RDBIStoreTest, EvictionWritesBackRegion)
+{
+    RDBIStore store(2, blkBits, blkIndexBits, 2, blksInRegion, false);
+    Writebacks wbs;
+
+    const Addr old0 = blkAddr(2, 1, 0, 2);
+    const Addr old1 = blkAddr(2, 1, 0, 9);
+    const Addr recent = blkAddr(2, 1, 1, 4);
+    const Addr incoming = blkAddr(2, 1, 2, 0);
+    store.markDirty(old0, fakeBlk(old0), 1, wbs.fn());
+    store.markDirty(old1, fakeBlk(old1), 2, wbs.fn());
+    store.markDirty(recent, fakeBlk(recent), 3, wbs.fn());
+    ASSERT_TRUE(wbs.blks.empty());
+
+    // The region of another set does not conflict
+    const Addr other = blkAddr(2, 0, 3, 0);
+    store.markDirty(other, fakeBlk(other), 4, wbs.fn());
+    ASSERT_TRUE(wbs.blks.empty());
+
+    store.markDirty(incoming, fakeBlk(incoming), 5, wbs.fn());
+    ASSERT_EQ(wbs.blks.size(), 2);
+    // The blocks are written back in address order, as a row batch
+    ASSERT_EQ(wbs.blks[0], std::make_tuple(old0, fakeBlk(old0), true));
+    ASSERT_EQ(wbs.blks[1], std::make_tuple(old1, fakeBlk(old1), true));
+
+    ASSERT_FALSE(store.isDirty(old0));
+    ASSERT_FALSE(store.isDirty(old1));
+    ASSERT_TRUE(store.isDirty(recent));
+    ASSERT_TRUE(store.isDirty(incoming));
+    ASSERT_EQ(store.numValid(), 3);
+}
+
+// A lone dirty block is not written back as a row batch
+TEST(RDBIStoreTest, SingleBlockIsNotRowBatch)
+{
+    RDBIStore store(1, blkBits, blkIndexBits, 1, blksInRegion, false);
+    Writebacks wbs;
+
+    const Addr a = blkAddr(1, 0, 0, 5);
+    const Addr b = blkAddr(1, 0, 1, 5);
+    store.markDirty(a, fakeBlk(a), 1, wbs.fn());
+    store.markDirty(b, fakeBlk(b), 2, wbs.fn());
+    ASSERT_EQ(wbs.blks.size(), 1);
+    ASSERT_EQ(wbs.blks[0], std::make_tuple(a, fakeBlk(a), false));
+}
+
+// With aggressive writeback, cleaning a block writes back every dirty block of its region
+TEST(RDBIStoreTest, AggressiveWriteback)
+{
+    RDBIStore store(4, blkBits, blkIndexBits, 2, blksInRegion, true);
+    Writebacks wbs;
+
+    const Addr a = blkAddr(4, 2, 0, 1);
+    const Addr b = blkAddr(4, 2, 0, 6);
+    store.markDirty(a, fakeBlk(a), 1, wbs.fn());
+    store.markDirty(b, fakeBlk(b), 2, wbs.fn());
+
+    store.clearDirty(a, RDBIWriteback, wbs.fn());
+    ASSERT_EQ(wbs.blks.size(), 2);
+    ASSERT_FALSE(store.isDirty(b));
+    ASSERT_FALSE(store.anyDirty());
+}
+
+// writebackRegion writes back the other dirty blocks of the region and keeps the block of the lookup
+TEST(RDBIStoreTest, WritebackRegion)
+{
+    RDBIStore store(4, blkBits, blkIndexBits, 2, blksInRegion, false);
+    Writebacks wbs;
+
+    const Addr a = blkAddr(4, 2, 0, 1);
+    const Addr b = blkAddr(4, 2, 0, 6);
+    const Addr c = blkAddr(4, 2, 0, 12);
+    store.markDirty(a, fakeBlk(a), 1, wbs.fn());
+    store.markDirty(b, fakeBlk(b), 2, wbs.fn());
+    store.markDirty(c, fakeBlk(c), 3, wbs.fn());
+
+    store.writebackRegion(store.lookup(b), wbs.fn());
+    ASSERT_EQ(wbs.blks.size(), 2);
+    ASSERT_EQ(std::get<0>(wbs.blks[0]), a);
+    ASSERT_EQ(std::get<0>(wbs.blks[1]), c);
+    ASSERT_FALSE(store.isDirty(a));
+    ASSERT_TRUE(store.isDirty(b));
+    ASSERT_FALSE(store.isDirty(c));
+
+    // The region is dropped if the block of the lookup is clean
+    wbs.blks.clear();
+    store.writebackRegion(store.lookup(a), wbs.fn());
+    ASSERT_EQ(wbs.blks.size(), 1);
+    ASSERT_EQ(std::get<0>(wbs.blks[0]), b);
+    ASSERT_FALSE(store.anyDirty());
+}
+
+// cleanRegion cleans the least recently written region, at most maxBlks blocks at a time
+TEST(RDBIStoreTest, CleanRegion)
+{
+    RDBIStore store(4, blkBits, blkIndexBits, 2, blksInRegion, false);
+    Writebacks wbs;
+
+    ASSERT_EQ(store.cleanRegion(4, wbs.fn()), 0);
+
+    const Addr recent = blkAddr(4, 0, 0, 0);
+    store.markDirty(recent, fakeBlk(recent), 100, wbs.fn());
+    for (unsigned int blk = 0; blk < 3; blk++)
+    {
+        const Addr addr = blkAddr(4, 3, 1, blk);
+        store.markDirty(addr, fakeBlk(addr), 10 + blk, wbs.fn());
+    }
+
+    ASSERT_EQ(store.cleanRegion(2, wbs.fn()), 2);
+    ASSERT_EQ(wbs.blks.size(), 2);
+    ASSERT_TRUE(std::get<2>(wbs.blks[0]));
+    ASSERT_TRUE(store.lookup(blkAddr(4, 3, 1, 2)).hit());
+
+    ASSERT_EQ(store.cleanRegion(2, wbs.fn()), 1);
+    ASSERT_EQ(wbs.blks.size(), 3);
+    ASSERT_FALSE(std::get<2>(wbs.blks[2]));
+    ASSERT_FALSE(store.lookup(blkAddr(4, 3, 1, 2)).hit());
+
+    ASSERT_EQ(store.cleanRegion(2, wbs.fn()), 1);
+    ASSERT_EQ(std::get<0>(wbs.blks[3]), recent);
+    ASSERT_FALSE(store.anyDirty());
+}
+
+// Regions of more than 64 blocks span several dirty bit words
+TEST(RDBIStoreTest, LargeRegions)
+{
+    const unsigned int bigIndexBits = 7;
+    RDBIStore store(2, blkBits, bigIndexBits, 1, 1 << bigIndexBits, false);
+    Writebacks wbs;
+
+    const Addr bigRegion = Addr(1) << (blkBits + bigIndexBits);
+    std::vector<Addr> dirty = {0, 63 << blkBits, 64 << blkBits, 127 << blkBits};
+    for (Addr addr : dirty)
+        store.markDirty(addr, fakeBlk(addr), 1, wbs.fn());
+    for (Addr addr : dirty)
+        ASSERT_TRUE(store.isDirty(addr));
+    ASSERT_FALSE(store.isDirty(65 << blkBits));
+
+    // Evict the region with a conflicting one
+    store.markDirty(2 * bigRegion, fakeBlk(2 * bigRegion), 2, wbs.fn());
+    ASSERT_EQ(wbs.blks.size(), dirty.size());
+    for (unsigned int i = 0; i < dirty.size(); i++)
+        ASSERT_EQ(std::get<0>(wbs.blks[i]), dirty[i]);
+}
+
+// A lookup handle of a missing region becomes a hit once markDirty inserts the region
+TEST(RDBIStoreTest, LookupHandle)
+{
+    RDBIStore store(4, blkBits, blkIndexBits, 2, blksInRegion, false);
+    Writebacks wbs;
+
+    const Addr a = blkAddr(4, 1, 0, 0);
+    const Addr b = blkAddr(4, 1, 0, 1);
+    RDBILookup dbiLookup = store.lookup(a);
+    ASSERT_FALSE(dbiLookup.hit());
+    store.markDirty(dbiLookup, fakeBlk(a), 1, wbs.fn());
+    ASSERT_TRUE(dbiLookup.hit());
+
+    // Lookups of the same region see the new entry
+    const RDBILookup other = store.lookup(b);
+    ASSERT_TRUE(other.hit());
+    ASSERT_EQ(other.entryIndex, dbiLookup.entryIndex);
+    ASSERT_EQ(other.blkIndex, 1);
+    ASSERT_FALSE(store.isDirty(other));
+
+    // Lookups made before the region is dropped do not hit afterwards
+    store.clearDirty(dbiLookup, RDBIWriteback, wbs.fn());
+    ASSERT_FALSE(store.lookup(b).hit());
+}
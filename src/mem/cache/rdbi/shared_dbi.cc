@@ -0,0 +1,198 @@
+#include "mem/cache/rdbi/shared_dbi.hh"
+
+#include <algorithm>
+#include <cmath>
+
+#include "base/bitfield.hh"
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/DBICache.hh"
+#include "mem/cache/dbi.hh"
+#include "params/SharedDBI.hh"
+
+using namespace std;
+
+namespace gem5
+{
+
+    SharedRDBI::SharedRDBI(unsigned int _numSets, unsigned int _numBlkBits, unsigned int _numblkIndexBits, unsigned int _assoc, unsigned int _numBlksInRegion, unsigned int _blkSize, bool _useAggressiveWriteback, replacement_policy::Base *_replacementPolicy, BaseIndexingPolicy *_indexingPolicy, RDBIStats &_rdbiStats, SharedDBI &_sharedDBI)
+        : RDBI(_numSets, _numBlkBits, _numblkIndexBits, _assoc, _numBlksInRegion, _blkSize, _useAggressiveWriteback, _replacementPolicy, _indexingPolicy, _rdbiStats, _sharedDBI.name()),
+          sharedDBI(_sharedDBI)
+    {
+    }
+
+    RDBIStore::WritebackFn
+    SharedRDBI::packetWriteback(PacketList &writebacks, MemCmd cmd) const
+    {
+        // The slice holding the block sends its writeback, so that it is ordered with the other requests of the block
+        // The writebacks of the calling slice are queued the same way, and sent with its next writebacks
+        return [this, cmd](Addr addr, CacheBlk *blk, bool isRowBatch)
+        { sharedDBI.queueWriteback(createWriteback(addr, blk, isRowBatch, cmd)); };
+    }
+
+    bool
+    SharedRDBI::anyDirty(const DBICache *slice) const
+    {
+        for (unsigned int entryIndex = 0; entryIndex < entries.size(); entryIndex++)
+        {
+            if (!validBits[entryIndex])
+                continue;
+
+            for (unsigned int w = 0; w < wordsPerEntry; w++)
+            {
+                uint64_t word = dirtyWords[entryIndex * wordsPerEntry + w];
+                while (word)
+                {
+                    unsigned int i = w * 64 + ctz64(word);
+                    word &= word - 1;
+                    if (sharedDBI.sliceOf(regenerateBlkAddr(regTags[entryIndex], i)) == slice)
+                        return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    void
+    SharedRDBI::forEachDirtyBlk(const DBICache *slice, std::function<void(CacheBlk &)> visitor) const
+    {
+        for (unsigned int entryIndex = 0; entryIndex < entries.size(); entryIndex++)
+        {
+            if (!validBits[entryIndex])
+                continue;
+
+            // The words are copied, since the visitor may clear the dirty bits of the entry
+            for (unsigned int w = 0; w < wordsPerEntry; w++)
+            {
+                uint64_t word = dirtyWords[entryIndex * wordsPerEntry + w];
+                while (word)
+                {
+                    unsigned int i = w * 64 + ctz64(word);
+                    word &= word - 1;
+                    if (sharedDBI.sliceOf(regenerateBlkAddr(regTags[entryIndex], i)) == slice)
+                        visitor(*blkPtrs[entryIndex * numBlksInRegion + i]);
+                }
+            }
+        }
+    }
+
+    SharedDBI::SharedDBIStats::SharedDBIStats(Stats::Group *parent)
+        : Stats::Group(parent),
+          ADD_STAT(accesses, "Number of lookups of the shared DBI"),
+          ADD_STAT(portWaitCycles, "Number of cycles the lookups waited for a port"),
+          ADD_STAT(avgPortWaitCycles, "Average number of cycles a lookup waited for a port"),
+          ADD_STAT(sliceWritebacks, "Number of writebacks of the shared RDBI, per slice")
+    {
+        avgPortWaitCycles = portWaitCycles / accesses;
+        sliceWritebacks
+            .flags(Stats::total | Stats::nozero);
+    }
+
+    SharedDBI::SharedDBI(const SharedDBIParams &p)
+        : ClockedObject(p),
+          blkSize(p.blkSize),
+          numBlksInRegion(p.blk_per_dbi_entry),
+          accessLatency(p.latency),
+          portFreeTicks(p.num_ports, 0),
+          stats(this),
+          rdbiStats(this)
+    {
+        fatal_if(p.num_ports == 0, "%s must have at least one port\n", name());
+        fatal_if(!isPowerOf2(numBlksInRegion) || numBlksInRegion > 512,
+                 "blk_per_dbi_entry of %s must be a power of two up to 512\n", name());
+
+        // Same geometry as the RDBI of a DBICache, sized from the total size of the slices
+        const uint32_t numBlksInCache = p.size / blkSize;
+        const uint32_t numDBIEntries = (numBlksInCache * p.alpha) / numBlksInRegion;
+        const uint32_t numDBISets = numDBIEntries / p.dbi_assoc;
+        rdbi = new SharedRDBI(numDBISets, log2(blkSize), log2(numBlksInRegion), p.dbi_assoc, numBlksInRegion, blkSize, p.aggr_writeback, p.dbi_replacement_policy, p.dbi_indexing_policy, rdbiStats, *this);
+    }
+
+    SharedRDBI *
+    SharedDBI::registerSlice(DBICache *slice, unsigned int sliceBlkSize, unsigned int sliceBlksInRegion)
+    {
+        fatal_if(sliceBlkSize != blkSize || sliceBlksInRegion != numBlksInRegion,
+                 "%s has %d blocks of %d bytes per region, but its shared DBI %s has %d blocks of %d bytes\n",
+                 slice->name(), sliceBlksInRegion, sliceBlkSize, name(), numBlksInRegion, blkSize);
+
+        slices.push_back(slice);
+        return rdbi;
+    }
+
+    void
+    SharedDBI::init()
+    {
+        ClockedObject::init();
+
+        fatal_if(slices.empty(), "%s is not used by any DBICache\n", name());
+
+        // The writebacks of a block are sent by the slice holding it, so the slices must not overlap
+        for (unsigned int i = 0; i < slices.size(); i++)
+        {
+            for (unsigned int j = i + 1; j < slices.size(); j++)
+            {
+                for (const auto &range_i : slices[i]->getAddrRanges())
+                {
+                    for (const auto &range_j : slices[j]->getAddrRanges())
+                    {
+                        fatal_if(range_i.intersects(range_j),
+                                 "%s and %s share %s but both hold %s, the slices need disjoint addr_ranges\n",
+                                 slices[i]->name(), slices[j]->name(), name(), range_i.to_string());
+                    }
+                }
+            }
+        }
+
+        stats.sliceWritebacks.init(slices.size());
+        for (unsigned int i = 0; i < slices.size(); i++)
+            stats.sliceWritebacks.subname(i, slices[i]->name());
+    }
+
+    unsigned int
+    SharedDBI::sliceIndex(Addr addr) const
+    {
+        for (unsigned int i = 0; i < slices.size(); i++)
+        {
+            for (const auto &range : slices[i]->getAddrRanges())
+            {
+                if (range.contains(addr))
+                    return i;
+            }
+        }
+        panic("%s: no slice holds address %#x\n", name(), addr);
+    }
+
+    void
+    SharedDBI::queueWriteback(PacketPtr wbPkt)
+    {
+        const unsigned int i = sliceIndex(wbPkt->getAddr());
+        stats.sliceWritebacks[i]++;
+        slices[i]->queueWriteback(wbPkt);
+    }
+
+    Tick
+    SharedDBI::access(bool is_timing)
+    {
+        stats.accesses++;
+
+        // Lookups start on a clock edge of the shared DBI
+        const Tick start = clockEdge();
+        if (!is_timing)
+            return start - curTick() + cyclesToTicks(accessLatency);
+
+        // Take the port that is free first, it is busy for one cycle
+        auto port = std::min_element(portFreeTicks.begin(), portFreeTicks.end());
+        const Tick portStart = std::max(start, *port);
+        *port = portStart + clockPeriod();
+
+        const Cycles waitCycles = ticksToCycles(portStart - start);
+        if (waitCycles > 0)
+        {
+            DPRINTF(DBICache, "Shared DBI lookup waits %d cycles for a port\n", waitCycles);
+            stats.portWaitCycles += waitCycles;
+        }
+
+        return portStart - curTick() + cyclesToTicks(accessLatency);
+    }
+}
@@ -0,0 +1,110 @@
+#ifndef _MEM_CACHE_RDBI_SHARED_DBI_HH_
+#define _MEM_CACHE_RDBI_SHARED_DBI_HH_
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "mem/cache/dbi_cache_stats.hh"
+#include "mem/cache/rdbi/rdbi.hh"
+#include "mem/packet.hh"
+#include "sim/clocked_object.hh"
+
+using namespace std;
+
+namespace gem5
+{
+    struct SharedDBIParams;
+    class DBICache;
+    class SharedDBI;
+
+    // The RDBI of a SharedDBI
+    // The dirty blocks of a region may be held by different slices, each of them is written back by its slice
+    class SharedRDBI : public RDBI
+    {
+
+    protected:
+        // SharedDBI owning the RDBI
+        SharedDBI &sharedDBI;
+
+        // Queue each writeback packet in the slice holding the block, instead of in the list of the caller
+        WritebackFn packetWriteback(PacketList &writebacks, MemCmd cmd) const override;
+
+    public:
+        SharedRDBI(unsigned int _numSets, unsigned int _numBlkBits, unsigned int _numblkIndexBits, unsigned int _assoc, unsigned int _numBlksInRegion, unsigned int _blkSize, bool _useAggressiveWriteback, replacement_policy::Base *_replacementPolicy, BaseIndexingPolicy *_indexingPolicy, RDBIStats &_rdbiStats, SharedDBI &_sharedDBI);
+
+        using RDBIStore::anyDirty;
+        using RDBIStore::forEachDirtyBlk;
+
+        // Check if any block held by the slice is dirty
+        bool anyDirty(const DBICache *slice) const;
+
+        // Visit the dirty cache blocks held by the slice, region by region
+        // The visitor may clear the dirty bit of the visited block
+        void forEachDirtyBlk(const DBICache *slice, std::function<void(CacheBlk &)> visitor) const;
+    };
+
+    // A DBI shared by the slices (or banks) of a cache
+    // The slices interleave the addresses of a region, so sharing the RDBI lets a region writeback
+    // gather the dirty blocks of a DRAM row from every slice
+    // A lookup pays the access latency of the shared DBI, plus the wait for one of its ports
+    class SharedDBI : public ClockedObject
+    {
+
+    protected:
+        // Cache block size
+        unsigned int blkSize;
+        // Number of cache blocks per region
+        unsigned int numBlksInRegion;
+
+        // Latency of a lookup, once it holds a port
+        const Cycles accessLatency;
+        // Tick from which each port is free, a port starts one lookup per cycle
+        std::vector<Tick> portFreeTicks;
+
+        // Slices sharing the DBI, in registration order
+        std::vector<DBICache *> slices;
+
+        // Get the index of the slice holding an address
+        unsigned int sliceIndex(Addr addr) const;
+
+        struct SharedDBIStats : public Stats::Group
+        {
+            SharedDBIStats(Stats::Group *parent);
+
+            Stats::Scalar accesses;
+            Stats::Scalar portWaitCycles;
+            Stats::Formula avgPortWaitCycles;
+            Stats::Vector sliceWritebacks;
+        } stats;
+
+        // Stats of the shared RDBI, the slices do not report them
+        RDBIStats rdbiStats;
+
+        // RDBI shared by the slices
+        SharedRDBI *rdbi;
+
+    public:
+        SharedDBI(const SharedDBIParams &p);
+
+        // Register a slice with its geometry, and return the RDBI it must use
+        SharedRDBI *registerSlice(DBICache *slice, unsigned int sliceBlkSize, unsigned int sliceBlksInRegion);
+
+        // Check that every address is held by a single slice
+        void init() override;
+
+        // Get the slice holding an address
+        DBICache *sliceOf(Addr addr) const { return slices[sliceIndex(addr)]; }
+
+        // Queue a writeback packet of the shared RDBI in the slice holding its block
+        void queueWriteback(PacketPtr wbPkt);
+
+        // Look up the shared DBI now, and return the ticks until the lookup completes
+        // Timing lookups wait for a free port, atomic lookups only pay the access latency
+        Tick access(bool is_timing);
+    };
+}
+
+#endif // _MEM_CACHE_RDBI_SHARED_DBI_HH_
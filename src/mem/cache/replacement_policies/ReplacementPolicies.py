@@ -149,3 +149,11 @@ class WeightedLRURP(LRURP):
     type = "WeightedLRURP"
     cxx_class = 'gem5::replacement_policy::WeightedLRU'
     cxx_header = "mem/cache/replacement_policies/weighted_lru_rp.hh"
+
+class CleanFirstRP(BaseReplacementPolicy):
+    type = 'CleanFirstRP'
+    cxx_class = 'gem5::replacement_policy::CleanFirst'
+    cxx_header = "mem/cache/replacement_policies/clean_first_rp.hh"
+
+    replacement_policy = Param.BaseReplacementPolicy(LRURP(),
+        "Sub-replacement policy used to choose among the clean candidates")
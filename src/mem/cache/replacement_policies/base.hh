@@ -104,6 +104,20 @@ class Base : public SimObject
     virtual ReplaceableEntry* getVictim(
                            const ReplacementCandidates& candidates) const = 0;
 
+    /**
+     * Find the victim getVictim() would choose among the candidates, without
+     * updating the replacement data, the statistics or the random number
+     * generator. Policies whose getVictim() has side effects override it.
+     *
+     * @param candidates Replacement candidates, selected by indexing policy.
+     * @return Replacement entry that would be replaced.
+     */
+    virtual ReplaceableEntry*
+    peekVictim(const ReplacementCandidates& candidates) const
+    {
+        return getVictim(candidates);
+    }
+
     /**
      * Instantiate a replacement data entry.
      *
@@ -94,7 +94,7 @@ BRRIP::reset(const std::shared_ptr<ReplacementData>& replacement_data) const
 }
 
 ReplaceableEntry*
-BRRIP::getVictim(const ReplacementCandidates& candidates) const
+BRRIP::peekVictim(const ReplacementCandidates& candidates) const
 {
     // There must be at least one replacement candidate
     assert(candidates.size() > 0);
@@ -125,10 +125,24 @@ BRRIP::getVictim(const ReplacementCandidates& candidates) const
         }
     }
 
+    return victim;
+}
+
+ReplaceableEntry*
+BRRIP::getVictim(const ReplacementCandidates& candidates) const
+{
+    ReplaceableEntry* victim = BRRIP::peekVictim(candidates);
+    std::shared_ptr<BRRIPReplData> victim_repl_data =
+        std::static_pointer_cast<BRRIPReplData>(victim->replacementData);
+
+    // An invalid entry is evicted without aging the other entries
+    if (!victim_repl_data->valid) {
+        return victim;
+    }
+
     // Get difference of victim's RRPV to the highest possible RRPV in
     // order to update the RRPV of all the other entries accordingly
-    int diff = std::static_pointer_cast<BRRIPReplData>(
-        victim->replacementData)->rrpv.saturate();
+    int diff = victim_repl_data->rrpv.saturate();
 
     // No need to update RRPV if there is no difference
     if (diff > 0){
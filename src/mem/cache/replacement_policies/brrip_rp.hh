@@ -149,6 +149,15 @@ class BRRIP : public Base
      * @param cands Replacement candidates, selected by indexing policy.
      * @return Replacement entry to be replaced.
      */
+    /**
+     * Find the victim with the highest rrpv, without aging the candidates.
+     *
+     * @param cands Replacement candidates, selected by indexing policy.
+     * @return Replacement entry that would be replaced.
+     */
+    ReplaceableEntry* peekVictim(const ReplacementCandidates& candidates) const
+                                                                     override;
+
     ReplaceableEntry* getVictim(const ReplacementCandidates& candidates) const
                                                                      override;
 
@@ -0,0 +1,103 @@
+#include "mem/cache/replacement_policies/clean_first_rp.hh"
+
+#include <cassert>
+
+#include "base/logging.hh"
+#include "params/CleanFirstRP.hh"
+
+namespace gem5
+{
+
+namespace replacement_policy
+{
+
+CleanFirst::CleanFirst(const Params &p)
+  : Base(p), replPolicy(p.replacement_policy)
+{
+    fatal_if(replPolicy == nullptr, "The sub-replacement policy of %s must "
+        "be instantiated", name());
+}
+
+void
+CleanFirst::setDirtyQuery(DirtyQuery query)
+{
+    isDirty = query;
+}
+
+void
+CleanFirst::invalidate(
+    const std::shared_ptr<ReplacementData>& replacement_data)
+{
+    replPolicy->invalidate(replacement_data);
+}
+
+void
+CleanFirst::touch(const std::shared_ptr<ReplacementData>& replacement_data,
+    const PacketPtr pkt)
+{
+    replPolicy->touch(replacement_data, pkt);
+}
+
+void
+CleanFirst::touch(
+    const std::shared_ptr<ReplacementData>& replacement_data) const
+{
+    replPolicy->touch(replacement_data);
+}
+
+void
+CleanFirst::reset(const std::shared_ptr<ReplacementData>& replacement_data,
+    const PacketPtr pkt)
+{
+    replPolicy->reset(replacement_data, pkt);
+}
+
+void
+CleanFirst::reset(
+    const std::shared_ptr<ReplacementData>& replacement_data) const
+{
+    replPolicy->reset(replacement_data);
+}
+
+ReplacementCandidates
+CleanFirst::victimCandidates(const ReplacementCandidates& candidates) const
+{
+    // There must be at least one replacement candidate
+    assert(candidates.size() > 0);
+    panic_if(!isDirty, "%s is not attached to a cache", name());
+
+    // Only the clean candidates can be evicted without a writeback
+    ReplacementCandidates clean_candidates;
+    clean_candidates.reserve(candidates.size());
+    for (const auto& candidate : candidates) {
+        if (!isDirty(candidate)) {
+            clean_candidates.push_back(candidate);
+        }
+    }
+
+    if (clean_candidates.empty()) {
+        return candidates;
+    }
+    return clean_candidates;
+}
+
+ReplaceableEntry*
+CleanFirst::getVictim(const ReplacementCandidates& candidates) const
+{
+    return replPolicy->getVictim(victimCandidates(candidates));
+}
+
+ReplaceableEntry*
+CleanFirst::peekVictim(const ReplacementCandidates& candidates) const
+{
+    return replPolicy->peekVictim(victimCandidates(candidates));
+}
+
+std::shared_ptr<ReplacementData>
+CleanFirst::instantiateEntry()
+{
+    return replPolicy->instantiateEntry();
+}
+
+} // namespace replacement_policy
+} // namespace gem5
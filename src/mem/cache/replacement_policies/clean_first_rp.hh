@@ -0,0 +1,129 @@
+/**
+ * @file
+ * Declaration of a clean-first replacement policy.
+ * The victim is chosen by a sub-policy among the clean candidates, so that
+ * an eviction does not generate a writeback whenever it can be avoided. If
+ * every candidate is dirty, the sub-policy chooses among all of them.
+ *
+ * The policy does not know how the owning cache keeps the dirty state of
+ * its blocks (e.g., in the blocks or in a dirty-block index), so the cache
+ * must provide it through setDirtyQuery().
+ */
+
+#ifndef __MEM_CACHE_REPLACEMENT_POLICIES_CLEAN_FIRST_RP_HH__
+#define __MEM_CACHE_REPLACEMENT_POLICIES_CLEAN_FIRST_RP_HH__
+
+#include <functional>
+#include <memory>
+
+#include "mem/cache/replacement_policies/base.hh"
+
+namespace gem5
+{
+
+struct CleanFirstRPParams;
+
+namespace replacement_policy
+{
+
+class CleanFirst : public Base
+{
+  public:
+    /** Function that tells whether a replacement candidate is dirty. */
+    typedef std::function<bool(const ReplaceableEntry*)> DirtyQuery;
+
+  protected:
+    /** Sub-replacement policy used to rank the candidates. */
+    Base* const replPolicy;
+
+    /** Dirty state query of the owning cache. */
+    DirtyQuery isDirty;
+
+    /**
+     * Get the candidates the sub-policy chooses from: the clean ones, or all
+     * of them if none is clean.
+     *
+     * @param candidates Replacement candidates, selected by indexing policy.
+     * @return Candidates of the sub-policy.
+     */
+    ReplacementCandidates victimCandidates(
+        const ReplacementCandidates& candidates) const;
+
+  public:
+    typedef CleanFirstRPParams Params;
+    CleanFirst(const Params &p);
+    ~CleanFirst() = default;
+
+    /**
+     * Set the function used to query the dirty state of the candidates.
+     * Must be called by the owning cache before the first replacement.
+     *
+     * @param query The dirty state query.
+     */
+    void setDirtyQuery(DirtyQuery query);
+
+    /**
+     * Invalidate replacement data to set it as the next probable victim.
+     * Forwarded to the sub-policy.
+     *
+     * @param replacement_data Replacement data to be invalidated.
+     */
+    void invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
+                                                                    override;
+
+    /**
+     * Touch an entry to update its replacement data.
+     * Forwarded to the sub-policy.
+     *
+     * @param replacement_data Replacement data to be touched.
+     * @param pkt Packet that generated this access.
+     */
+    void touch(const std::shared_ptr<ReplacementData>& replacement_data,
+        const PacketPtr pkt) override;
+    void touch(const std::shared_ptr<ReplacementData>& replacement_data) const
+                                                                     override;
+
+    /**
+     * Reset replacement data. Used when an entry is inserted.
+     * Forwarded to the sub-policy.
+     *
+     * @param replacement_data Replacement data to be reset.
+     * @param pkt Packet that generated this access.
+     */
+    void reset(const std::shared_ptr<ReplacementData>& replacement_data,
+        const PacketPtr pkt) override;
+    void reset(const std::shared_ptr<ReplacementData>& replacement_data) const
+                                                                     override;
+
+    /**
+     * Find replacement victim among the clean candidates using the
+     * sub-policy. Falls back to all the candidates if none is clean.
+     *
+     * @param candidates Replacement candidates, selected by indexing policy.
+     * @return Replacement entry to be replaced.
+     */
+    ReplaceableEntry* getVictim(const ReplacementCandidates& candidates) const
+                                                                     override;
+
+    /**
+     * Find the victim getVictim() would choose, using the side-effect-free
+     * victim query of the sub-policy.
+     *
+     * @param candidates Replacement candidates, selected by indexing policy.
+     * @return Replacement entry that would be replaced.
+     */
+    ReplaceableEntry* peekVictim(const ReplacementCandidates& candidates) const
+                                                                     override;
+
+    /**
+     * Instantiate a replacement data entry of the sub-policy.
+     *
+     * @return A shared pointer to the new replacement data.
+     */
+    std::shared_ptr<ReplacementData> instantiateEntry() override;
+};
+
+} // namespace replacement_policy
+} // namespace gem5
+
+#endif // __MEM_CACHE_REPLACEMENT_POLICIES_CLEAN_FIRST_RP_HH__
@@ -107,7 +107,8 @@ Dueling::reset(const std::shared_ptr<ReplacementData>& replacement_data) const
 }
 
 ReplaceableEntry*
-Dueling::getVictim(const ReplacementCandidates& candidates) const
+Dueling::chooseVictim(const ReplacementCandidates& candidates,
+                      bool peek) const
 {
     // This function assumes that all candidates are either part of the same
     // sampled set, or are not samples.
@@ -129,13 +130,13 @@ Dueling::getVictim(const ReplacementCandidates& candidates) const
     // if the candidates are its samples - in which case they must always
     // use X - or if it is not a sample, and X is currently the best RP.
     // This assumes that A's team is "false", and B's team is "true".
-    bool team_a;
-    if ((is_sample && !team) || (!is_sample && !winner)) {
-        duelingStats.selectedA++;
-        team_a = true;
-    } else {
-        duelingStats.selectedB++;
-        team_a = false;
+    const bool team_a = (is_sample && !team) || (!is_sample && !winner);
+    if (!peek) {
+        if (team_a) {
+            duelingStats.selectedA++;
+        } else {
+            duelingStats.selectedB++;
+        }
     }
 
     // Create a temporary list of replacement candidates which re-routes the
@@ -162,8 +163,9 @@ Dueling::getVictim(const ReplacementCandidates& candidates) const
     }
 
     // Use the selected replacement policy to find the victim
-    ReplaceableEntry* victim = team_a ? replPolicyA->getVictim(candidates) :
-        replPolicyB->getVictim(candidates);
+    Base* const repl_policy = team_a ? replPolicyA : replPolicyB;
+    ReplaceableEntry* victim = peek ? repl_policy->peekVictim(candidates) :
+        repl_policy->getVictim(candidates);
 
     // Search for entry within the original candidates and clean-up duplicates
     for (int i = 0; i < candidates.size(); i++) {
@@ -173,6 +175,18 @@ Dueling::getVictim(const ReplacementCandidates& candidates) const
     return victim;
 }
 
+ReplaceableEntry*
+Dueling::getVictim(const ReplacementCandidates& candidates) const
+{
+    return chooseVictim(candidates, false);
+}
+
+ReplaceableEntry*
+Dueling::peekVictim(const ReplacementCandidates& candidates) const
+{
+    return chooseVictim(candidates, true);
+}
+
 std::shared_ptr<ReplacementData>
 Dueling::instantiateEntry()
 {
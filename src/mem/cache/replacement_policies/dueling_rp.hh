@@ -93,6 +93,17 @@ class Dueling : public Base
         statistics::Scalar selectedB;
     } duelingStats;
 
+    /**
+     * Find replacement victim with the sub-policy of the winning team.
+     *
+     * @param candidates Replacement candidates, selected by indexing policy.
+     * @param peek Whether to use the side-effect-free victim query, without
+     *             updating the statistics.
+     * @return Replacement entry to be replaced.
+     */
+    ReplaceableEntry* chooseVictim(const ReplacementCandidates& candidates,
+                                   bool peek) const;
+
   public:
     PARAMS(DuelingRP);
     Dueling(const Params &p);
@@ -110,6 +121,8 @@ class Dueling : public Base
                                                                      override;
     ReplaceableEntry* getVictim(const ReplacementCandidates& candidates) const
                                                                      override;
+    ReplaceableEntry* peekVictim(const ReplacementCandidates& candidates) const
+                                                                     override;
     std::shared_ptr<ReplacementData> instantiateEntry() override;
 };
 
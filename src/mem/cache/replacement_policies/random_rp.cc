@@ -30,6 +30,7 @@
 
 #include <cassert>
 #include <memory>
+#include <random>
 
 #include "base/random.hh"
 #include "params/RandomRP.hh"
@@ -68,14 +69,10 @@ Random::reset(const std::shared_ptr<ReplacementData>& replacement_data) const
 }
 
 ReplaceableEntry*
-Random::getVictim(const ReplacementCandidates& candidates) const
+Random::chooseVictim(const ReplacementCandidates& candidates,
+                     unsigned index) const
 {
-    // There must be at least one replacement candidate
-    assert(candidates.size() > 0);
-
-    // Choose one candidate at random
-    ReplaceableEntry* victim = candidates[random_mt.random<unsigned>(0,
-                                    candidates.size() - 1)];
+    ReplaceableEntry* victim = candidates[index];
 
     // Visit all candidates to search for an invalid entry. If one is found,
     // its eviction is prioritized
@@ -90,6 +87,30 @@ Random::getVictim(const ReplacementCandidates& candidates) const
     return victim;
 }
 
+ReplaceableEntry*
+Random::getVictim(const ReplacementCandidates& candidates) const
+{
+    // There must be at least one replacement candidate
+    assert(candidates.size() > 0);
+
+    // Choose one candidate at random
+    return chooseVictim(candidates,
+        random_mt.random<unsigned>(0, candidates.size() - 1));
+}
+
+ReplaceableEntry*
+Random::peekVictim(const ReplacementCandidates& candidates) const
+{
+    // There must be at least one replacement candidate
+    assert(candidates.size() > 0);
+
+    // Draw the candidate getVictim() would draw next, leaving the generator
+    // untouched
+    std::mt19937_64 gen = random_mt.gen;
+    std::uniform_int_distribution<unsigned> dist(0, candidates.size() - 1);
+    return chooseVictim(candidates, dist(gen));
+}
+
 std::shared_ptr<ReplacementData>
 Random::instantiateEntry()
 {
@@ -64,6 +64,16 @@ class Random : public Base
         RandomReplData() : valid(false) {}
     };
 
+    /**
+     * Find replacement victim, given the candidate drawn at random.
+     *
+     * @param candidates Replacement candidates, selected by indexing policy.
+     * @param index Index of the candidate drawn at random.
+     * @return Replacement entry to be replaced.
+     */
+    ReplaceableEntry* chooseVictim(const ReplacementCandidates& candidates,
+                                   unsigned index) const;
+
   public:
     typedef RandomRPParams Params;
     Random(const Params &p);
@@ -105,6 +115,16 @@ class Random : public Base
     ReplaceableEntry* getVictim(const ReplacementCandidates& candidates) const
                                                                      override;
 
+    /**
+     * Find the victim getVictim() would choose, drawing from a copy of the
+     * random number generator.
+     *
+     * @param candidates Replacement candidates, selected by indexing policy.
+     * @return Replacement entry that would be replaced.
+     */
+    ReplaceableEntry* peekVictim(const ReplacementCandidates& candidates) const
+                                                                     override;
+
     /**
      * Instantiate a replacement data entry.
      *
@@ -29,6 +29,7 @@
 #include "mem/cache/replacement_policies/second_chance_rp.hh"
 
 #include <cassert>
+#include <vector>
 
 #include "params/SecondChanceRP.hh"
 
@@ -132,6 +133,48 @@ SecondChance::getVictim(const ReplacementCandidates& candidates) const
     return victim;
 }
 
+ReplaceableEntry*
+SecondChance::peekVictim(const ReplacementCandidates& candidates) const
+{
+    // There must be at least one replacement candidate
+    assert(candidates.size() > 0);
+
+    // Replay the search of getVictim() on a copy of the insertion ticks and
+    // second chance bits
+    std::vector<Tick> ticks;
+    std::vector<bool> chances;
+    for (const auto& candidate : candidates) {
+        std::shared_ptr<SecondChanceReplData> candidate_replacement_data =
+            std::static_pointer_cast<SecondChanceReplData>(
+                candidate->replacementData);
+        ticks.push_back(candidate_replacement_data->tickInserted);
+        chances.push_back(candidate_replacement_data->hasSecondChance);
+
+        // Invalid entries have the eviction priority
+        if ((ticks.back() == Tick(0)) && !chances.back()) {
+            return candidate;
+        }
+    }
+
+    while (true) {
+        // Do a FIFO victim search
+        std::size_t victim = 0;
+        for (std::size_t i = 0; i < candidates.size(); i++) {
+            if (ticks[i] < ticks[victim]) {
+                victim = i;
+            }
+        }
+
+        if (!chances[victim]) {
+            return candidates[victim];
+        }
+
+        // Use the second chance of the copy
+        ticks[victim] = curTick();
+        chances[victim] = false;
+    }
+}
+
 std::shared_ptr<ReplacementData>
 SecondChance::instantiateEntry()
 {
@@ -120,6 +120,16 @@ class SecondChance : public FIFO
     ReplaceableEntry* getVictim(const ReplacementCandidates& candidates) const
                                                                      override;
 
+    /**
+     * Find the victim getVictim() would choose, without using the second
+     * chances of the candidates.
+     *
+     * @param cands Replacement candidates, selected by indexing policy.
+     * @return Replacement entry that would be replaced.
+     */
+    ReplaceableEntry* peekVictim(const ReplacementCandidates& candidates) const
+                                                                     override;
+
     /**
      * Instantiate a replacement data entry.
      *
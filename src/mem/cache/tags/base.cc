@@ -83,8 +83,8 @@ BaseTags::findBlock(Addr addr, bool is_secure) const
     Addr tag = extractTag(addr);
 
     // Find possible entries that may contain the given address
-    const std::vector<ReplaceableEntry*> entries =
-        indexingPolicy->getPossibleEntries(addr);
+    const std::vector<ReplaceableEntry*>& entries =
+        indexingPolicy->getPossibleEntries(addr, possibleEntries);
 
     // Search for block
     for (const auto& location : entries) {
@@ -50,6 +50,7 @@
 #include <cstdint>
 #include <functional>
 #include <string>
+#include <vector>
 
 #include "base/callback.hh"
 #include "base/logging.hh"
@@ -88,6 +89,13 @@ class BaseTags : public ClockedObject
     /** Indexing policy */
     BaseIndexingPolicy *indexingPolicy;
 
+    /**
+     * Storage for the possible entries of a lookup, for the indexing
+     * policies that cannot return them in place. It is reused by every
+     * lookup, so that they do not allocate.
+     */
+    mutable std::vector<ReplaceableEntry*> possibleEntries;
+
     /**
      * The number of tags that need to be touched to meet the warmup
      * percentage.
@@ -282,6 +290,21 @@ class BaseTags : public ClockedObject
                                  const std::size_t size,
                                  std::vector<CacheBlk*>& evict_blks) = 0;
 
+    /**
+     * Find the blocks findVictim() would evict for an address, without
+     * updating the replacement data or the statistics. Used to decide
+     * whether a fill would evict dirty data before doing it.
+     * @sa findVictim
+     *
+     * @param addr Address to find a victim for.
+     * @param is_secure True if the target memory space is secure.
+     * @param size Size, in bits, of new block to allocate.
+     * @param evict_blks Cache blocks that would be evicted.
+     */
+    virtual void peekVictim(Addr addr, const bool is_secure,
+                            const std::size_t size,
+                            std::vector<CacheBlk*>& evict_blks) const = 0;
+
     /**
      * Access block and update replacement data. May not succeed, in which case
      * nullptr is returned. This has all the implications of a cache access and
@@ -170,8 +170,8 @@ class BaseSetAssoc : public BaseTags
                          std::vector<CacheBlk*>& evict_blks) override
     {
         // Get possible entries to be victimized
-        const std::vector<ReplaceableEntry*> entries =
-            indexingPolicy->getPossibleEntries(addr);
+        const std::vector<ReplaceableEntry*>& entries =
+            indexingPolicy->getPossibleEntries(addr, possibleEntries);
 
         // Choose replacement victim from replacement candidates
         CacheBlk* victim = static_cast<CacheBlk*>(replacementPolicy->getVictim(
@@ -183,6 +183,24 @@ class BaseSetAssoc : public BaseTags
         return victim;
     }
 
+    /**
+     * Find the victim findVictim() would choose, without updating the
+     * replacement data.
+     *
+     * @param addr Address to find a victim for.
+     * @param is_secure True if the target memory space is secure.
+     * @param size Size, in bits, of new block to allocate.
+     * @param evict_blks Cache blocks that would be evicted.
+     */
+    void peekVictim(Addr addr, const bool is_secure, const std::size_t size,
+                    std::vector<CacheBlk*>& evict_blks) const override
+    {
+        const std::vector<ReplaceableEntry*>& entries =
+            indexingPolicy->getPossibleEntries(addr, possibleEntries);
+        evict_blks.push_back(static_cast<CacheBlk*>(
+            replacementPolicy->peekVictim(entries)));
+    }
+
     /**
      * Insert the new block into the cache and update replacement data.
      *
@@ -101,14 +101,15 @@ CompressedTags::tagsInit()
     }
 }
 
-CacheBlk*
-CompressedTags::findVictim(Addr addr, const bool is_secure,
-                           const std::size_t compressed_size,
-                           std::vector<CacheBlk*>& evict_blks)
+SectorSubBlk*
+CompressedTags::findVictimBlks(Addr addr, const bool is_secure,
+                               const std::size_t compressed_size,
+                               std::vector<CacheBlk*>& evict_blks,
+                               bool peek) const
 {
     // Get all possible locations of this superblock
-    const std::vector<ReplaceableEntry*> superblock_entries =
-        indexingPolicy->getPossibleEntries(addr);
+    const std::vector<ReplaceableEntry*>& superblock_entries =
+        indexingPolicy->getPossibleEntries(addr, possibleEntries);
 
     // Check if the superblock this address belongs to has been allocated. If
     // so, try co-allocating
@@ -133,7 +134,8 @@ CompressedTags::findVictim(Addr addr, const bool is_secure,
     // superblock must be replaced
     if (victim_superblock == nullptr){
         // Choose replacement victim from replacement candidates
-        victim_superblock = static_cast<SuperBlk*>(
+        victim_superblock = static_cast<SuperBlk*>(peek ?
+            replacementPolicy->peekVictim(superblock_entries) :
             replacementPolicy->getVictim(superblock_entries));
 
         // The whole superblock must be evicted to make room for the new one
@@ -153,16 +155,37 @@ CompressedTags::findVictim(Addr addr, const bool is_secure,
         assert(!victim->isValid());
 
         // Print all co-allocated blocks
-        DPRINTF(CacheComp, "Co-Allocation: offset %d of %s\n", offset,
-                victim_superblock->print());
+        if (!peek) {
+            DPRINTF(CacheComp, "Co-Allocation: offset %d of %s\n", offset,
+                    victim_superblock->print());
+        }
     }
 
+    return victim;
+}
+
+CacheBlk*
+CompressedTags::findVictim(Addr addr, const bool is_secure,
+                           const std::size_t compressed_size,
+                           std::vector<CacheBlk*>& evict_blks)
+{
+    SectorSubBlk* victim = findVictimBlks(addr, is_secure, compressed_size,
+                                          evict_blks, false);
+
     // Update number of sub-blocks evicted due to a replacement
     sectorStats.evictionsReplacement[evict_blks.size()]++;
 
     return victim;
 }
 
+void
+CompressedTags::peekVictim(Addr addr, const bool is_secure,
+                           const std::size_t compressed_size,
+                           std::vector<CacheBlk*>& evict_blks) const
+{
+    findVictimBlks(addr, is_secure, compressed_size, evict_blks, true);
+}
+
 void
 CompressedTags::forEachBlk(std::function<void(CacheBlk &)> visitor)
 {
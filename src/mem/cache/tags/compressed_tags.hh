@@ -75,6 +75,23 @@ class CompressedTags : public SectorTags
     /** The cache superblocks. */
     std::vector<SuperBlk> superBlks;
 
+    /**
+     * Find the victim of an address and the blocks to be evicted, without
+     * updating the statistics.
+     *
+     * @param addr Address to find a victim for.
+     * @param is_secure True if the target memory space is secure.
+     * @param compressed_size Size, in bits, of new block to allocate.
+     * @param evict_blks Cache blocks to be evicted.
+     * @param peek Whether to use the side-effect-free victim query of the
+     *             replacement policy.
+     * @return Cache block to be replaced.
+     */
+    SectorSubBlk* findVictimBlks(Addr addr, const bool is_secure,
+                                 const std::size_t compressed_size,
+                                 std::vector<CacheBlk*>& evict_blks,
+                                 bool peek) const;
+
   public:
     /** Convenience typedef. */
      typedef CompressedTagsParams Params;
@@ -108,6 +125,19 @@ class CompressedTags : public SectorTags
                          const std::size_t compressed_size,
                          std::vector<CacheBlk*>& evict_blks) override;
 
+    /**
+     * Find the blocks findVictim() would evict, without updating the
+     * replacement data or the statistics.
+     *
+     * @param addr Address to find a victim for.
+     * @param is_secure True if the target memory space is secure.
+     * @param compressed_size Size, in bits, of new block to allocate.
+     * @param evict_blks Cache blocks that would be evicted.
+     */
+    void peekVictim(Addr addr, const bool is_secure,
+                    const std::size_t compressed_size,
+                    std::vector<CacheBlk*>& evict_blks) const override;
+
     /**
      * Visit each sub-block in the tags and apply a visitor.
      *
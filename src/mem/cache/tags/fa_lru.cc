@@ -202,6 +202,13 @@ FALRU::findVictim(Addr addr, const bool is_secure, const std::size_t size,
     return victim;
 }
 
+void
+FALRU::peekVictim(Addr addr, const bool is_secure, const std::size_t size,
+                  std::vector<CacheBlk*>& evict_blks) const
+{
+    evict_blks.push_back(tail);
+}
+
 void
 FALRU::insertBlock(const PacketPtr pkt, CacheBlk *blk)
 {
@@ -221,6 +221,17 @@ class FALRU : public BaseTags
                          const std::size_t size,
                          std::vector<CacheBlk*>& evict_blks) override;
 
+    /**
+     * Find the victim findVictim() would choose: the tail.
+     *
+     * @param addr Address to find a victim for.
+     * @param is_secure True if the target memory space is secure.
+     * @param size Size, in bits, of new block to allocate.
+     * @param evict_blks Cache blocks that would be evicted.
+     */
+    void peekVictim(Addr addr, const bool is_secure, const std::size_t size,
+                    std::vector<CacheBlk*>& evict_blks) const override;
+
     /**
      * Insert the new block into the cache and update replacement data.
      *
@@ -149,6 +149,20 @@ class BaseIndexingPolicy : public SimObject
     virtual std::vector<ReplaceableEntry*> getPossibleEntries(const Addr addr)
                                                                     const = 0;
 
+    /**
+     * Find all possible entries for insertion and replacement of an address,
+     * without allocating them on every lookup. Policies whose possible
+     * entries form one of the sets return that set; the others fill the
+     * buffer, whose capacity is kept across lookups, and return it. The
+     * result is only valid until the next call on the same buffer.
+     *
+     * @param addr The addr to a find possible entries for.
+     * @param buffer Storage for the possible entries, if they are not a set.
+     * @return The possible entries.
+     */
+    virtual const std::vector<ReplaceableEntry*>& getPossibleEntries(
+        const Addr addr, std::vector<ReplaceableEntry*>& buffer) const = 0;
+
     /**
      * Regenerate an entry's address from its tag and assigned indexing bits.
      *
@@ -118,6 +118,18 @@ class SetAssociative : public BaseIndexingPolicy
     std::vector<ReplaceableEntry*> getPossibleEntries(const Addr addr) const
                                                                      override;
 
+    /**
+     * Find all possible entries for insertion and replacement of an address,
+     * without copying them. Returns the set of the address, the buffer is
+     * not used.
+     *
+     * @param addr The addr to a find possible entries for.
+     * @param buffer Unused.
+     * @return The possible entries.
+     */
+    const std::vector<ReplaceableEntry*>& getPossibleEntries(const Addr addr,
+        std::vector<ReplaceableEntry*>& buffer) const override;
+
     /**
      * Regenerate an entry's address from its tag and assigned set and way.
      *
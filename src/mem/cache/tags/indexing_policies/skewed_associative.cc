@@ -210,14 +210,24 @@ std::vector<ReplaceableEntry*>
 SkewedAssociative::getPossibleEntries(const Addr addr) const
 {
     std::vector<ReplaceableEntry*> entries;
+    getPossibleEntries(addr, entries);
+    return entries;
+}
+
+const std::vector<ReplaceableEntry*>&
+SkewedAssociative::getPossibleEntries(const Addr addr,
+    std::vector<ReplaceableEntry*>& buffer) const
+{
+    // Keep the capacity of the buffer, it only grows on its first use
+    buffer.resize(assoc);
 
     // Parse all ways
     for (uint32_t way = 0; way < assoc; ++way) {
         // Apply hash to get set, and get way entry in it
-        entries.push_back(sets[extractSet(addr, way)][way]);
+        buffer[way] = sets[extractSet(addr, way)][way];
     }
 
-    return entries;
+    return buffer;
 }
 
 } // namespace gem5
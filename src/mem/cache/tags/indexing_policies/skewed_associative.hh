@@ -163,6 +163,17 @@ class SkewedAssociative : public BaseIndexingPolicy
     std::vector<ReplaceableEntry*> getPossibleEntries(const Addr addr) const
                                                                    override;
 
+    /**
+     * Find all possible entries for insertion and replacement of an address,
+     * one per way, in the buffer.
+     *
+     * @param addr The addr to a find possible entries for.
+     * @param buffer Storage for the possible entries.
+     * @return The buffer, holding the possible entries.
+     */
+    const std::vector<ReplaceableEntry*>& getPossibleEntries(const Addr addr,
+        std::vector<ReplaceableEntry*>& buffer) const override;
+
     /**
      * Regenerate an entry's address from its tag and assigned set and way.
      * Uses the inverse of the skewing function.
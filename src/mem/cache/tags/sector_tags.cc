@@ -257,8 +257,8 @@ SectorTags::findBlock(Addr addr, bool is_secure) const
     const Addr offset = extractSectorOffset(addr);
 
     // Find all possible sector entries that may contain the given address
-    const std::vector<ReplaceableEntry*> entries =
-        indexingPolicy->getPossibleEntries(addr);
+    const std::vector<ReplaceableEntry*>& entries =
+        indexingPolicy->getPossibleEntries(addr, possibleEntries);
 
     // Search for block
     for (const auto& sector : entries) {
@@ -272,13 +272,14 @@ SectorTags::findBlock(Addr addr, bool is_secure) const
     return nullptr;
 }
 
-CacheBlk*
-SectorTags::findVictim(Addr addr, const bool is_secure, const std::size_t size,
-                       std::vector<CacheBlk*>& evict_blks)
+SectorSubBlk*
+SectorTags::findVictimBlks(Addr addr, const bool is_secure,
+                           std::vector<CacheBlk*>& evict_blks,
+                           bool peek) const
 {
     // Get possible entries to be victimized
-    const std::vector<ReplaceableEntry*> sector_entries =
-        indexingPolicy->getPossibleEntries(addr);
+    const std::vector<ReplaceableEntry*>& sector_entries =
+        indexingPolicy->getPossibleEntries(addr, possibleEntries);
 
     // Check if the sector this address belongs to has been allocated
     Addr tag = extractTag(addr);
@@ -294,8 +295,9 @@ SectorTags::findVictim(Addr addr, const bool is_secure, const std::size_t size,
     // If the sector is not present
     if (victim_sector == nullptr){
         // Choose replacement victim from replacement candidates
-        victim_sector = static_cast<SectorBlk*>(replacementPolicy->getVictim(
-                                                sector_entries));
+        victim_sector = static_cast<SectorBlk*>(peek ?
+            replacementPolicy->peekVictim(sector_entries) :
+            replacementPolicy->getVictim(sector_entries));
     }
 
     // Get the entry of the victim block within the sector
@@ -316,12 +318,28 @@ SectorTags::findVictim(Addr addr, const bool is_secure, const std::size_t size,
         }
     }
 
+    return victim;
+}
+
+CacheBlk*
+SectorTags::findVictim(Addr addr, const bool is_secure, const std::size_t size,
+                       std::vector<CacheBlk*>& evict_blks)
+{
+    SectorSubBlk* victim = findVictimBlks(addr, is_secure, evict_blks, false);
+
     // Update number of sub-blocks evicted due to a replacement
     sectorStats.evictionsReplacement[evict_blks.size()]++;
 
     return victim;
 }
 
+void
+SectorTags::peekVictim(Addr addr, const bool is_secure, const std::size_t size,
+                       std::vector<CacheBlk*>& evict_blks) const
+{
+    findVictimBlks(addr, is_secure, evict_blks, true);
+}
+
 int
 SectorTags::extractSectorOffset(Addr addr) const
 {
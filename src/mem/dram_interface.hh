@@ -746,6 +746,12 @@ class DRAMInterface : public MemInterface
         return ranks[pkt->rank]->inRefIdleState();
     }
 
+    bool
+    rowOpen(const MemPacket* pkt) const override
+    {
+        return ranks[pkt->rank]->banks[pkt->bank].openRow == pkt->row;
+    }
+
     /**
      * This function checks if ranks are actively refreshing and
      * therefore busy. The function also checks if ranks are in
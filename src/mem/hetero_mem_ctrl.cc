@@ -235,7 +235,8 @@ HeteroMemCtrl::chooseNext(MemPacketQueue& queue, Tick extra_col_delay,
                     break;
                 }
             }
-        } else if (memSchedPolicy == enums::frfcfs) {
+        } else if (memSchedPolicy == enums::frfcfs ||
+                   memSchedPolicy == enums::frfcfs_rowbatch) {
             Tick col_allowed_at;
             std::tie(ret, col_allowed_at)
                     = chooseNextFRFCFS(queue, extra_col_delay, mem_int);
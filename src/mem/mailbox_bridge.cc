@@ -0,0 +1,292 @@
+/**
+ * @file
+ * Implementation of a bridge whose two sides may be simulated by
+ * different event queues.
+ */
+
+#include "mem/mailbox_bridge.hh"
+
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/Drain.hh"
+#include "debug/MailboxBridge.hh"
+#include "params/MailboxBridge.hh"
+
+namespace gem5
+{
+
+MailboxBridge::Mailbox::Mailbox(const std::string &_name,
+                                EventQueue *_destQueue,
+                                std::function<bool(PacketPtr)> _send,
+                                std::function<void()> _emptied)
+    : Named(_name), destQueue(_destQueue), send(_send), emptied(_emptied),
+      deliveryPending(false), refused(nullptr),
+      deliverEvent([this]{ deliver(); }, _name)
+{
+}
+
+void
+MailboxBridge::Mailbox::post(PacketPtr pkt, Tick when)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Like the queues of Bridge, the packets are delivered in order,
+    // each one no earlier than its tick
+    posted.emplace_back(pkt, when);
+
+    // Wake up the receiving side, unless it will look at the mailbox
+    // anyway. The event queue inserts the event asynchronously if it
+    // belongs to another thread.
+    if (!deliveryPending) {
+        deliveryPending = true;
+        destQueue->schedule(&deliverEvent, when);
+    }
+}
+
+void
+MailboxBridge::Mailbox::deliver()
+{
+    while (!refused) {
+        PacketPtr pkt = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            if (posted.empty()) {
+                deliveryPending = false;
+            } else if (posted.front().tick > curTick()) {
+                destQueue->schedule(&deliverEvent, posted.front().tick);
+                return;
+            } else {
+                pkt = posted.front().pkt;
+                posted.pop_front();
+            }
+        }
+
+        // Tell the bridge without the lock, as it looks at both mailboxes
+        if (!pkt) {
+            emptied();
+            return;
+        }
+
+        // The packet is sent without the lock, the receiving side may
+        // post to the other mailbox while handling it
+        DPRINTF(MailboxBridge, "Delivering %s\n", pkt->print());
+        if (!send(pkt)) {
+            DPRINTF(MailboxBridge, "Delivery refused, waiting for retry\n");
+            refused = pkt;
+        }
+    }
+}
+
+void
+MailboxBridge::Mailbox::retry()
+{
+    assert(refused);
+
+    PacketPtr pkt = refused;
+    refused = nullptr;
+    if (!send(pkt)) {
+        refused = pkt;
+        return;
+    }
+
+    // Carry on with the packets that became due while waiting
+    deliver();
+}
+
+bool
+MailboxBridge::Mailbox::trySatisfyFunctional(PacketPtr pkt)
+{
+    if (refused && pkt->trySatisfyFunctional(refused)) {
+        pkt->makeResponse();
+        return true;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto &posted_pkt : posted) {
+        if (pkt->trySatisfyFunctional(posted_pkt.pkt)) {
+            pkt->makeResponse();
+            return true;
+        }
+    }
+    return false;
+}
+
+bool
+MailboxBridge::Mailbox::empty()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return !deliveryPending && !refused && posted.empty();
+}
+
+MailboxBridge::MailboxResponsePort::MailboxResponsePort(
+        const std::string &_name, MailboxBridge &_bridge)
+    : ResponsePort(_name, &_bridge), bridge(_bridge)
+{
+}
+
+MailboxBridge::MailboxRequestPort::MailboxRequestPort(
+        const std::string &_name, MailboxBridge &_bridge)
+    : RequestPort(_name, &_bridge), bridge(_bridge)
+{
+}
+
+MailboxBridge::MailboxBridge(const Params &p)
+    : SimObject(p), delay(p.delay),
+      ranges(p.ranges.begin(), p.ranges.end()),
+      memSideQueue(getEventQueue(p.mem_side_eventq_index)),
+      cpuSidePort(p.name + ".cpu_side_port", *this),
+      memSidePort(p.name + ".mem_side_port", *this),
+      requests(p.name + ".requests", memSideQueue,
+               [this](PacketPtr pkt)
+               { return memSidePort.sendTimingReq(pkt); },
+               [this]{ checkDrained(); }),
+      responses(p.name + ".responses", eventQueue(),
+                [this](PacketPtr pkt)
+                { return cpuSidePort.sendTimingResp(pkt); },
+                [this]{ checkDrained(); })
+{
+}
+
+Port &
+MailboxBridge::getPort(const std::string &if_name, PortID idx)
+{
+    if (if_name == "mem_side_port")
+        return memSidePort;
+    else if (if_name == "cpu_side_port")
+        return cpuSidePort;
+    else
+        return SimObject::getPort(if_name, idx);
+}
+
+void
+MailboxBridge::init()
+{
+    if (!cpuSidePort.isConnected() || !memSidePort.isConnected())
+        fatal("Both ports of %s must be connected.\n", name());
+
+    cpuSidePort.sendRangeChange();
+}
+
+void
+MailboxBridge::startup()
+{
+    // The quantum is only known once the simulation starts. A packet
+    // posted during a quantum must reach the other queue after the
+    // barrier that ends it.
+    fatal_if(memSideQueue != eventQueue() && numMainEventQueues > 1 &&
+             delay <= simQuantum,
+             "The delay of %s (%d ticks) must be larger than the simulation "
+             "quantum (%d ticks), as its sides are on different event "
+             "queues.\n", name(), delay, simQuantum);
+}
+
+DrainState
+MailboxBridge::drain()
+{
+    std::lock_guard<std::mutex> lock(drainMutex);
+
+    if (requests.empty() && responses.empty())
+        return DrainState::Drained;
+
+    DPRINTF(Drain, "MailboxBridge not drained\n");
+    return DrainState::Draining;
+}
+
+void
+MailboxBridge::checkDrained()
+{
+    // Both sides may find their mailbox empty at the same time, the lock
+    // makes sure that only one of them signals
+    std::lock_guard<std::mutex> lock(drainMutex);
+
+    if (drainState() == DrainState::Draining && requests.empty() &&
+        responses.empty()) {
+        DPRINTF(Drain, "MailboxBridge done draining, signaling drain "
+                "manager\n");
+        signalDrainDone();
+    }
+}
+
+void
+MailboxBridge::post(Mailbox &mailbox, PacketPtr pkt)
+{
+    // Like Bridge, the packet only reaches us after its header delay,
+    // and its payload still has to be deserialised
+    Tick receive_delay = pkt->headerDelay + pkt->payloadDelay;
+    pkt->headerDelay = pkt->payloadDelay = 0;
+
+    mailbox.post(pkt, curTick() + delay + receive_delay);
+}
+
+bool
+MailboxBridge::MailboxResponsePort::recvTimingReq(PacketPtr pkt)
+{
+    DPRINTF(MailboxBridge, "recvTimingReq: %s\n", pkt->print());
+
+    panic_if(pkt->cacheResponding(), "Should not see packets where cache "
+             "is responding");
+
+    bridge.post(bridge.requests, pkt);
+    return true;
+}
+
+void
+MailboxBridge::MailboxResponsePort::recvRespRetry()
+{
+    bridge.responses.retry();
+}
+
+Tick
+MailboxBridge::MailboxResponsePort::recvAtomic(PacketPtr pkt)
+{
+    panic_if(pkt->cacheResponding(), "Should not see packets where cache "
+             "is responding");
+
+    // The event queues are only locked while simulating in parallel
+    EventQueue::ScopedMigration migrate(bridge.memSideQueue, inParallelMode);
+    return bridge.delay + bridge.memSidePort.sendAtomic(pkt);
+}
+
+void
+MailboxBridge::MailboxResponsePort::recvFunctional(PacketPtr pkt)
+{
+    pkt->pushLabel(name());
+
+    // The responses are delivered on this side
+    if (bridge.responses.trySatisfyFunctional(pkt))
+        return;
+
+    EventQueue::ScopedMigration migrate(bridge.memSideQueue, inParallelMode);
+
+    // and the requests on the memory side
+    if (bridge.requests.trySatisfyFunctional(pkt))
+        return;
+
+    pkt->popLabel();
+
+    bridge.memSidePort.sendFunctional(pkt);
+}
+
+AddrRangeList
+MailboxBridge::MailboxResponsePort::getAddrRanges() const
+{
+    return bridge.ranges;
+}
+
+bool
+MailboxBridge::MailboxRequestPort::recvTimingResp(PacketPtr pkt)
+{
+    DPRINTF(MailboxBridge, "recvTimingResp: %s\n", pkt->print());
+
+    bridge.post(bridge.responses, pkt);
+    return true;
+}
+
+void
+MailboxBridge::MailboxRequestPort::recvReqRetry()
+{
+    bridge.requests.retry();
+}
+
+} // namespace gem5
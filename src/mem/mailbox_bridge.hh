@@ -0,0 +1,234 @@
+/**
+ * @file
+ * Declaration of a bridge whose two sides may be simulated by
+ * different event queues, hence different threads.
+ */
+
+#ifndef __MEM_MAILBOX_BRIDGE_HH__
+#define __MEM_MAILBOX_BRIDGE_HH__
+
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+
+#include "base/named.hh"
+#include "base/types.hh"
+#include "mem/port.hh"
+#include "params/MailboxBridge.hh"
+#include "sim/eventq.hh"
+#include "sim/sim_object.hh"
+
+namespace gem5
+{
+
+/**
+ * A bridge connecting a requestor and a responder simulated by
+ * different event queues. The CPU side runs on the event queue of the
+ * bridge, the memory side on the event queue given by
+ * mem_side_eventq_index.
+ *
+ * Timing packets cross through a mailbox in each direction. The thread
+ * of the sending side posts a packet with its delivery tick, and the
+ * thread of the receiving side delivers it at that tick. As the queues
+ * only synchronise once per simulation quantum, the latency of the
+ * bridge must be larger than the quantum, so that a packet is never
+ * delivered in the past of the receiving queue. The delivery ticks do
+ * not depend on the number of threads, so the bridge behaves the same
+ * when both sides share a queue.
+ *
+ * The mailboxes never refuse a packet, as the sending thread cannot
+ * wait for the receiving one. Flow control is only applied on the
+ * receiving side, where a refused packet waits for a retry. The bridge
+ * does not carry snoops, like Bridge. Atomic and functional accesses
+ * migrate to the event queue of the memory side. The bridge is drained
+ * once both mailboxes are empty.
+ */
+class MailboxBridge : public SimObject
+{
+  protected:
+
+    /**
+     * A one-way mailbox between two event queues.
+     */
+    class Mailbox : public Named
+    {
+      public:
+
+        /**
+         * @param _name Name of the mailbox, used by its event.
+         * @param _destQueue Event queue of the receiving side.
+         * @param _send Send a packet on the receiving side.
+         * @param _emptied Called on the receiving side when the last
+         *                 packet has been delivered.
+         */
+        Mailbox(const std::string &_name, EventQueue *_destQueue,
+                std::function<bool(PacketPtr)> _send,
+                std::function<void()> _emptied);
+
+        /**
+         * Post a packet, from the thread of the sending side.
+         *
+         * @param pkt The packet.
+         * @param when The tick it must be delivered at.
+         */
+        void post(PacketPtr pkt, Tick when);
+
+        /**
+         * Send the refused packet again, from the thread of the
+         * receiving side.
+         */
+        void retry();
+
+        /**
+         * Check if a posted packet satisfies a functional access, from
+         * the thread of the receiving side.
+         */
+        bool trySatisfyFunctional(PacketPtr pkt);
+
+        /**
+         * Check if the mailbox holds no packet, neither posted nor
+         * refused, and is not delivering one.
+         */
+        bool empty();
+
+      private:
+
+        /** Send the packets that are due, on the receiving side. */
+        void deliver();
+
+        struct PostedPacket
+        {
+            const Tick tick;
+            const PacketPtr pkt;
+
+            PostedPacket(PacketPtr _pkt, Tick _tick)
+                : tick(_tick), pkt(_pkt)
+            { }
+        };
+
+        /** Event queue of the receiving side. */
+        EventQueue *const destQueue;
+
+        const std::function<bool(PacketPtr)> send;
+
+        const std::function<void()> emptied;
+
+        /** Protects the posted packets and deliveryPending. */
+        std::mutex mutex;
+
+        /** Posted packets, in order of delivery. */
+        std::deque<PostedPacket> posted;
+
+        /**
+         * True if the receiving side will look at the posted packets
+         * again, either on the delivery event or on a retry.
+         */
+        bool deliveryPending;
+
+        /** Packet refused by the receiving side, waiting for a retry. */
+        PacketPtr refused;
+
+        EventFunctionWrapper deliverEvent;
+    };
+
+    class MailboxRequestPort;
+
+    class MailboxResponsePort : public ResponsePort
+    {
+      private:
+
+        MailboxBridge &bridge;
+
+      public:
+
+        MailboxResponsePort(const std::string &_name,
+                            MailboxBridge &_bridge);
+
+      protected:
+
+        bool recvTimingReq(PacketPtr pkt) override;
+
+        void recvRespRetry() override;
+
+        Tick recvAtomic(PacketPtr pkt) override;
+
+        void recvFunctional(PacketPtr pkt) override;
+
+        AddrRangeList getAddrRanges() const override;
+    };
+
+    class MailboxRequestPort : public RequestPort
+    {
+      private:
+
+        MailboxBridge &bridge;
+
+      public:
+
+        MailboxRequestPort(const std::string &_name,
+                           MailboxBridge &_bridge);
+
+      protected:
+
+        bool recvTimingResp(PacketPtr pkt) override;
+
+        void recvReqRetry() override;
+    };
+
+    /** Latency of the bridge, in ticks. */
+    const Tick delay;
+
+    /** Address ranges to pass through the bridge. */
+    const AddrRangeList ranges;
+
+    /** Event queue of the memory side. */
+    EventQueue *memSideQueue;
+
+    MailboxResponsePort cpuSidePort;
+
+    MailboxRequestPort memSidePort;
+
+    /** Requests, from the CPU side to the memory side. */
+    Mailbox requests;
+
+    /** Responses, from the memory side to the CPU side. */
+    Mailbox responses;
+
+    /**
+     * Serialises the drain checks of the two sides, which may run on
+     * different threads.
+     */
+    std::mutex drainMutex;
+
+    /**
+     * Signal the end of a drain once both mailboxes are empty, from the
+     * thread of either side.
+     */
+    void checkDrained();
+
+    /**
+     * Post a timing packet to a mailbox, after the latency of the bridge
+     * and the header and payload delays of the packet.
+     */
+    void post(Mailbox &mailbox, PacketPtr pkt);
+
+  public:
+
+    typedef MailboxBridgeParams Params;
+
+    MailboxBridge(const Params &p);
+
+    Port &getPort(const std::string &if_name,
+                  PortID idx=InvalidPortID) override;
+
+    void init() override;
+
+    void startup() override;
+
+    DrainState drain() override;
+};
+
+} // namespace gem5
+
+#endif //__MEM_MAILBOX_BRIDGE_HH__
@@ -72,7 +72,9 @@ MemCtrl::MemCtrl(const MemCtrlParams &p) :
     writeLowThreshold(writeBufferSize * p.write_low_thresh_perc / 100.0),
     minWritesPerSwitch(p.min_writes_per_switch),
     minReadsPerSwitch(p.min_reads_per_switch),
-    writesThisTime(0), readsThisTime(0),
+    writesThisTime(0), readsThisTime(0), writeRowHitsThisTime(0),
+    rowBatchDrain(p.row_batch_drain), rowBatchOpen(false),
+    rowBatchChannel(0), rowBatchRank(0), rowBatchBank(0), rowBatchRow(0),
     memSchedPolicy(p.mem_sched_policy),
     frontendLatency(p.static_frontend_latency),
     backendLatency(p.static_backend_latency),
@@ -577,7 +579,8 @@ MemCtrl::chooseNext(MemPacketQueue& queue, Tick extra_col_delay,
                     break;
                 }
             }
-        } else if (memSchedPolicy == enums::frfcfs) {
+        } else if (memSchedPolicy == enums::frfcfs ||
+                   memSchedPolicy == enums::frfcfs_rowbatch) {
             Tick col_allowed_at;
             std::tie(ret, col_allowed_at)
                     = chooseNextFRFCFS(queue, extra_col_delay, mem_intr);
@@ -609,6 +612,56 @@ MemCtrl::chooseNextFRFCFS(MemPacketQueue& queue, Tick extra_col_delay,
     return std::make_pair(selected_pkt_it, col_allowed_at);
 }
 
+MemPacketQueue::iterator
+MemCtrl::chooseNextRowBatch(MemPacketQueue& queue, MemInterface* mem_intr)
+{
+    assert(rowBatchOpen);
+
+    // take the first write of the open batch that can issue, it goes to
+    // the row the previous batched write opened
+    for (auto i = queue.begin(); i != queue.end(); ++i) {
+        MemPacket* mem_pkt = *i;
+        if (inRowBatch(mem_pkt) &&
+            mem_pkt->pseudoChannel == rowBatchChannel &&
+            mem_pkt->rank == rowBatchRank && mem_pkt->bank == rowBatchBank &&
+            mem_pkt->row == rowBatchRow && packetReady(mem_pkt, mem_intr)) {
+            DPRINTF(MemCtrl, "Continuing row batch in bank %d, row %d\n",
+                    mem_pkt->bank, mem_pkt->row);
+            return i;
+        }
+    }
+
+    return queue.end();
+}
+
+bool
+MemCtrl::inRowBatch(const MemPacket* mem_pkt) const
+{
+    return memSchedPolicy == enums::frfcfs_rowbatch ||
+        (rowBatchDrain && mem_pkt->isRowBatch());
+}
+
+bool
+MemCtrl::rowBatchPending() const
+{
+    if (!rowBatchOpen)
+        return false;
+
+    for (const auto& queue : writeQueue) {
+        for (const auto& mem_pkt : queue) {
+            if (inRowBatch(mem_pkt) &&
+                mem_pkt->pseudoChannel == rowBatchChannel &&
+                mem_pkt->rank == rowBatchRank &&
+                mem_pkt->bank == rowBatchBank &&
+                mem_pkt->row == rowBatchRow) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
 void
 MemCtrl::accessAndRespond(PacketPtr pkt, Tick static_latency,
                                                 MemInterface* mem_intr)
@@ -793,6 +846,10 @@ MemCtrl::doBurstAccess(MemPacket* mem_pkt, MemInterface* mem_intr)
     // When was command issued?
     Tick cmd_at;
 
+    // Check if the burst hits in the open row before the access
+    // changes the bank state
+    bool row_hit = mem_intr->rowOpen(mem_pkt);
+
     // Issue the next burst and update bus state to reflect
     // when previous command was issued
     std::vector<MemPacketQueue>& queue = selQueue(mem_pkt->isRead());
@@ -817,6 +874,8 @@ MemCtrl::doBurstAccess(MemPacket* mem_pkt, MemInterface* mem_intr)
         stats.requestorReadBytes[mem_pkt->requestorId()] += mem_pkt->size;
     } else {
         ++writesThisTime;
+        if (row_hit)
+            ++writeRowHitsThisTime;
         stats.requestorWriteBytes[mem_pkt->requestorId()] += mem_pkt->size;
         stats.requestorWriteTotalLat[mem_pkt->requestorId()] +=
             mem_pkt->readyTime - mem_pkt->entryTime;
@@ -901,7 +960,11 @@ MemCtrl::processNextReqEvent(MemInterface* mem_intr,
                     "Switching to reads after %d writes with %d writes "
                     "waiting\n", writesThisTime, totalWriteQueueSize);
             stats.wrPerTurnAround.sample(writesThisTime);
+            if (writesThisTime)
+                stats.wrRowHitRatePerTurnAround.sample(
+                    100 * writeRowHitsThisTime / writesThisTime);
             writesThisTime = 0;
+            writeRowHitsThisTime = 0;
         }
     }
 
@@ -1052,10 +1115,17 @@ MemCtrl::processNextReqEvent(MemInterface* mem_intr,
                     "Checking WRITE queue [%d] priority [%d elements]\n",
                     prio, queue->size());
 
+            // If we are in the middle of a row batch, keep draining it in
+            // the open row before looking at any other write
+            to_write = rowBatchOpen ? chooseNextRowBatch((*queue), mem_intr) :
+                                      queue->end();
+
             // If we are changing command type, incorporate the minimum
             // bus turnaround delay
-            to_write = chooseNext((*queue),
-                    switched_cmd_type ? minReadToWriteDataGap() : 0, mem_intr);
+            if (to_write == queue->end()) {
+                to_write = chooseNext((*queue), switched_cmd_type ?
+                                      minReadToWriteDataGap() : 0, mem_intr);
+            }
 
             if (to_write != queue->end()) {
                 write_found = true;
@@ -1084,6 +1154,19 @@ MemCtrl::processNextReqEvent(MemInterface* mem_intr,
 
         isInWriteQueue.erase(burstAlign(mem_pkt->addr, mem_intr));
 
+        // remember where a row batch is being drained, so that the rest
+        // of the batch follows this write in the same row
+        if (inRowBatch(mem_pkt)) {
+            stats.rowBatchWrBursts++;
+            rowBatchOpen = true;
+            rowBatchChannel = mem_pkt->pseudoChannel;
+            rowBatchRank = mem_pkt->rank;
+            rowBatchBank = mem_pkt->bank;
+            rowBatchRow = mem_pkt->row;
+        } else {
+            rowBatchOpen = false;
+        }
+
         // log the response
         logResponse(MemCtrl::WRITE, mem_pkt->requestorId(),
                     mem_pkt->qosValue(), mem_pkt->getAddr(), 1,
@@ -1101,16 +1184,32 @@ MemCtrl::processNextReqEvent(MemInterface* mem_intr,
         // writes, then switch to reads.
         // If we are interfacing to NVM and have filled the writeRespQueue,
         // with only NVM writes in Q, then switch to reads
+        // An unfinished row batch holds off the switch to reads, unless
+        // the write queue is empty or NVM writes are blocking the bus.
         bool below_threshold =
             totalWriteQueueSize + minWritesPerSwitch < writeLowThreshold;
+        bool switch_to_reads = totalWriteQueueSize == 0 ||
+            (totalReadQueueSize && (nvmWriteBlock(mem_intr)));
+
+        rowBatchOpen = rowBatchPending();
+
+        if (!switch_to_reads &&
+            ((below_threshold && drainState() != DrainState::Draining) ||
+             (totalReadQueueSize && writesThisTime >= minWritesPerSwitch))) {
+            if (rowBatchOpen) {
+                DPRINTF(MemCtrl, "Deferring switch to reads to finish the "
+                        "row batch in bank %d, row %d\n", rowBatchBank,
+                        rowBatchRow);
+                stats.rowBatchSwitchesDeferred++;
+            } else {
+                switch_to_reads = true;
+            }
+        }
 
-        if (totalWriteQueueSize == 0 ||
-            (below_threshold && drainState() != DrainState::Draining) ||
-            (totalReadQueueSize && writesThisTime >= minWritesPerSwitch) ||
-            (totalReadQueueSize && (nvmWriteBlock(mem_intr)))) {
-
+        if (switch_to_reads) {
             // turn the bus back around for reads again
             busStateNext = MemCtrl::READ;
+            rowBatchOpen = false;
 
             // note that the we switch back to reads also in the idle
             // case, which eventually will check for any draining and
@@ -1209,6 +1308,14 @@ MemCtrl::CtrlStats::CtrlStats(MemCtrl &_ctrl)
     ADD_STAT(wrPerTurnAround, statistics::units::Count::get(),
              "Writes before turning the bus around for reads"),
 
+    ADD_STAT(rowBatchWrBursts, statistics::units::Count::get(),
+             "Number of write bursts issued as part of a row batch"),
+    ADD_STAT(rowBatchSwitchesDeferred, statistics::units::Count::get(),
+             "Number of switches to reads deferred to finish a row batch"),
+    ADD_STAT(wrRowHitRatePerTurnAround, statistics::units::Ratio::get(),
+             "Percent of the writes hitting an open row, per write period "
+             "before turning the bus around for reads"),
+
     ADD_STAT(bytesReadWrQ, statistics::units::Byte::get(),
              "Total number of bytes read from write queue"),
     ADD_STAT(bytesReadSys, statistics::units::Byte::get(),
@@ -1279,6 +1386,9 @@ MemCtrl::CtrlStats::regStats()
     wrPerTurnAround
         .init(ctrl.writeBufferSize)
         .flags(nozero);
+    wrRowHitRatePerTurnAround
+        .init(0, 100, 5)
+        .flags(nozero);
 
     avgRdBWSys.precision(8);
     avgWrBWSys.precision(8);
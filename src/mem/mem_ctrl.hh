@@ -116,6 +116,9 @@ class MemPacket
     /** Does this packet access DRAM?*/
     const bool dram;
 
+    /** Is this write part of a row batch (e.g. a DBI region flush)? */
+    const bool rowBatch;
+
     /** pseudo channel num*/
     const uint8_t pseudoChannel;
 
@@ -203,12 +206,20 @@ class MemPacket
      */
     inline bool isDram() const { return dram; }
 
+    /**
+     * Return true if this write belongs to a batch of writebacks to
+     * the same memory region
+     */
+    inline bool isRowBatch() const { return rowBatch; }
+
     MemPacket(PacketPtr _pkt, bool is_read, bool is_dram, uint8_t _channel,
                uint8_t _rank, uint8_t _bank, uint32_t _row, uint16_t bank_id,
                Addr _addr, unsigned int _size)
         : entryTime(curTick()), readyTime(curTick()), pkt(_pkt),
           _requestorId(pkt->requestorId()),
-          read(is_read), dram(is_dram), pseudoChannel(_channel), rank(_rank),
+          read(is_read), dram(is_dram),
+          rowBatch(!is_read && _pkt->req->isRowBatch()),
+          pseudoChannel(_channel), rank(_rank),
           bank(_bank), row(_row), bankId(bank_id), addr(_addr), size(_size),
           burstHelper(NULL), _qosValue(_pkt->qosValue())
     { }
@@ -429,6 +440,36 @@ class MemCtrl : public qos::MemCtrl
     chooseNextFRFCFS(MemPacketQueue& queue, Tick extra_col_delay,
                     MemInterface* mem_intr);
 
+    /**
+     * While a row batch is being drained, look for the next write of
+     * the same batch, i.e. a batched write to the row the previous
+     * batched write went to.
+     *
+     * @param queue Queued writes to consider
+     * @param mem_intr the memory interface to choose from
+     * @return an iterator to the selected packet, else queue.end()
+     */
+    MemPacketQueue::iterator chooseNextRowBatch(MemPacketQueue& queue,
+                                                MemInterface* mem_intr);
+
+    /**
+     * Check if a write is drained as part of a row batch, either
+     * because it is tagged as one or because the frfcfs_rowbatch
+     * policy batches every write.
+     *
+     * @param mem_pkt Write to check
+     * @return true if the write belongs to a row batch
+     */
+    bool inRowBatch(const MemPacket* mem_pkt) const;
+
+    /**
+     * Check if there are still batched writes queued for the row
+     * batch that is currently being drained.
+     *
+     * @return true if the open row batch has queued writes
+     */
+    bool rowBatchPending() const;
+
     /**
      * Calculate burst window aligned tick
      *
@@ -516,6 +557,24 @@ class MemCtrl : public qos::MemCtrl
     const uint32_t minReadsPerSwitch;
     uint32_t writesThisTime;
     uint32_t readsThisTime;
+    uint32_t writeRowHitsThisTime;
+
+    /**
+     * Drain writes tagged as a row batch back-to-back in their row
+     * before turning the bus around for reads.
+     */
+    const bool rowBatchDrain;
+
+    /**
+     * The last write issued was part of a row batch, and the location
+     * of that batch, used to keep the remaining writes of the batch
+     * together.
+     */
+    bool rowBatchOpen;
+    uint8_t rowBatchChannel;
+    uint8_t rowBatchRank;
+    uint8_t rowBatchBank;
+    uint32_t rowBatchRow;
 
     /**
      * Memory controller configuration initialized based on parameter
@@ -587,6 +646,10 @@ class MemCtrl : public qos::MemCtrl
         statistics::Histogram rdPerTurnAround;
         statistics::Histogram wrPerTurnAround;
 
+        statistics::Scalar rowBatchWrBursts;
+        statistics::Scalar rowBatchSwitchesDeferred;
+        statistics::Distribution wrRowHitRatePerTurnAround;
+
         statistics::Scalar bytesReadWrQ;
         statistics::Scalar bytesReadSys;
         statistics::Scalar bytesWrittenSys;
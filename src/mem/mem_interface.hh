@@ -267,6 +267,16 @@ class MemInterface : public AbstractMemory
      */
     virtual bool burstReady(MemPacket* pkt) const = 0;
 
+    /**
+     * Check if the row of a packet is open in its bank, i.e. if a
+     * burst issued now would be a row hit. Media without a row
+     * buffer never hit.
+     *
+     * @param pkt Packet to check
+     * @return true if the row of the packet is open
+     */
+    virtual bool rowOpen(const MemPacket* pkt) const { return false; }
+
     /**
      * Determine the required delay for an access to a different rank
      *
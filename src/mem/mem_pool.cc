@@ -0,0 +1,148 @@
+#include "mem/mem_pool.hh"
+
+#include <atomic>
+#include <cstdint>
+#include <new>
+
+namespace gem5
+{
+
+namespace mem_pool
+{
+
+namespace
+{
+
+constexpr std::size_t numSizes = maxPooledSize / granularity;
+
+/** A free chunk holds the link to the next one. */
+struct FreeChunk
+{
+    FreeChunk *next;
+};
+
+/** The chunks of a thread, one freelist per pooled size. */
+struct ThreadPool
+{
+    /** Chunks freed by the thread, only touched by the thread. */
+    FreeChunk *freeLists[numSizes] = {};
+
+    /**
+     * Chunks freed by the other threads, pushed without a lock and
+     * taken back as a whole by the thread when a freelist runs out.
+     */
+    std::atomic<FreeChunk *> returned[numSizes] = {};
+};
+
+/**
+ * The slabs are aligned to their size, and start with the pool of the
+ * thread that carved them, so that a chunk can find its way back.
+ */
+struct SlabHeader
+{
+    ThreadPool *owner;
+};
+
+static_assert(sizeof(SlabHeader) <= granularity,
+              "The slab header must not misalign the chunks");
+static_assert((slabSize & (slabSize - 1)) == 0,
+              "The slabs must be aligned to their size");
+
+/**
+ * Pool of the calling thread. Neither the pools nor the slabs are ever
+ * given back to the heap, as the other threads may still return chunks
+ * to a pool once its thread has exited.
+ */
+ThreadPool &
+localPool()
+{
+    thread_local ThreadPool *pool = new ThreadPool;
+    return *pool;
+}
+
+std::size_t
+sizeIndex(std::size_t size)
+{
+    return size == 0 ? 0 : (size - 1) / granularity;
+}
+
+/**
+ * Refill an empty freelist, with the chunks returned by the other
+ * threads if there are any, or by carving a new slab.
+ */
+void
+refill(ThreadPool &pool, std::size_t index)
+{
+    FreeChunk *head =
+        pool.returned[index].exchange(nullptr, std::memory_order_acquire);
+    if (head) {
+        pool.freeLists[index] = head;
+        return;
+    }
+
+    const std::size_t chunk_size = (index + 1) * granularity;
+    char *slab = static_cast<char *>(
+        ::operator new(slabSize, std::align_val_t(slabSize)));
+    reinterpret_cast<SlabHeader *>(slab)->owner = &pool;
+
+    for (std::size_t offset = granularity; offset + chunk_size <= slabSize;
+         offset += chunk_size) {
+        FreeChunk *chunk = reinterpret_cast<FreeChunk *>(slab + offset);
+        chunk->next = head;
+        head = chunk;
+    }
+    pool.freeLists[index] = head;
+}
+
+} // anonymous namespace
+
+void *
+allocate(std::size_t size)
+{
+    if (size > maxPooledSize)
+        return ::operator new(size);
+
+    ThreadPool &pool = localPool();
+    const std::size_t index = sizeIndex(size);
+    if (!pool.freeLists[index])
+        refill(pool, index);
+
+    FreeChunk *chunk = pool.freeLists[index];
+    pool.freeLists[index] = chunk->next;
+    return chunk;
+}
+
+void
+deallocate(void *p, std::size_t size)
+{
+    if (!p)
+        return;
+
+    if (size > maxPooledSize) {
+        ::operator delete(p);
+        return;
+    }
+
+    const std::size_t index = sizeIndex(size);
+    FreeChunk *chunk = static_cast<FreeChunk *>(p);
+    ThreadPool *owner = reinterpret_cast<SlabHeader *>(
+        reinterpret_cast<uintptr_t>(p) & ~(slabSize - 1))->owner;
+
+    ThreadPool &pool = localPool();
+    if (owner == &pool) {
+        chunk->next = pool.freeLists[index];
+        pool.freeLists[index] = chunk;
+        return;
+    }
+
+    // Give the chunk back to its thread, so that the chunks do not pile
+    // up in the threads that free more than they allocate
+    chunk->next = owner->returned[index].load(std::memory_order_relaxed);
+    while (!owner->returned[index].compare_exchange_weak(chunk->next, chunk,
+               std::memory_order_release, std::memory_order_relaxed)) {
+    }
+}
+
+} // namespace mem_pool
+
+} // namespace gem5
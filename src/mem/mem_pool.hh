@@ -0,0 +1,88 @@
+/**
+ * @file
+ * Pooled allocation of the packets, requests and data buffers of the
+ * memory system. Each thread, hence each event queue of a parallel
+ * simulation, recycles its chunks through its own freelists, so that
+ * the allocations need no locking. The chunks freed by another thread
+ * go back to the thread that allocated them, through a lock-free stack
+ * it takes over when it runs out of chunks. The pool is only used when
+ * gem5 is built with USE_MEM_POOL.
+ */
+
+#ifndef __MEM_MEM_POOL_HH__
+#define __MEM_MEM_POOL_HH__
+
+#include <cstddef>
+
+namespace gem5
+{
+
+namespace mem_pool
+{
+
+/** Largest size served by the pool, larger sizes use the heap. */
+constexpr std::size_t maxPooledSize = 512;
+
+/** The pooled sizes are rounded up to a multiple of the granularity. */
+constexpr std::size_t granularity = 16;
+
+/**
+ * Size of the slabs the chunks of a size are carved from. The slabs are
+ * aligned to their size, which must be a power of two.
+ */
+constexpr std::size_t slabSize = 64 * 1024;
+
+/**
+ * Allocate a chunk from the freelists of the calling thread.
+ *
+ * @param size The size of the chunk, in bytes.
+ * @return The chunk, aligned as memory from operator new.
+ */
+void *allocate(std::size_t size);
+
+/**
+ * Give a chunk back to the freelists of the thread that allocated it,
+ * which may be another thread than the calling one.
+ *
+ * @param p The chunk.
+ * @param size The size it was allocated with.
+ */
+void deallocate(void *p, std::size_t size);
+
+/**
+ * Allocator drawing from the pool, for std::allocate_shared.
+ */
+template <class T>
+struct Allocator
+{
+    typedef T value_type;
+
+    Allocator() = default;
+
+    template <class U>
+    Allocator(const Allocator<U> &) {}
+
+    T *
+    allocate(std::size_t n)
+    {
+        return static_cast<T *>(mem_pool::allocate(n * sizeof(T)));
+    }
+
+    void
+    deallocate(T *p, std::size_t n)
+    {
+        mem_pool::deallocate(p, n * sizeof(T));
+    }
+
+    template <class U>
+    bool operator==(const Allocator<U> &) const { return true; }
+
+    template <class U>
+    bool operator!=(const Allocator<U> &) const { return false; }
+};
+
+} // namespace mem_pool
+
+} // namespace gem5
+
+#endif //__MEM_MEM_POOL_HH__
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "mem/mem_pool.hh"
+
+using namespace gem5;
+
+TEST(MemPoolTest, RecyclesChunksOfTheSameSize)
+{
+    void *chunk = mem_pool::allocate(64);
+    mem_pool::deallocate(chunk, 64);
+
+    // The freelists are LIFO, and sizes of the same granule share them
+    EXPECT_EQ(mem_pool::allocate(64), chunk);
+    mem_pool::deallocate(chunk, 64);
+    EXPECT_EQ(mem_pool::allocate(49), chunk);
+    mem_pool::deallocate(chunk, 49);
+}
+
+TEST(MemPoolTest, ChunksAreDistinctAndAligned)
+{
+    std::vector<void *> chunks;
+    std::set<void *> distinct;
+
+    // More than a slab, so that the pool refills
+    const std::size_t num_chunks = 2 * mem_pool::slabSize / 64;
+    for (std::size_t i = 0; i < num_chunks; i++) {
+        void *chunk = mem_pool::allocate(64);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(chunk) %
+                  mem_pool::granularity, 0);
+        // The whole chunk is usable
+        std::memset(chunk, int(i), 64);
+        chunks.push_back(chunk);
+        distinct.insert(chunk);
+    }
+    EXPECT_EQ(distinct.size(), num_chunks);
+
+    for (std::size_t i = 0; i < num_chunks; i++) {
+        EXPECT_EQ(*static_cast<uint8_t *>(chunks[i]), uint8_t(i));
+        mem_pool::deallocate(chunks[i], 64);
+    }
+}
+
+TEST(MemPoolTest, LargeSizesUseTheHeap)
+{
+    const std::size_t size = mem_pool::maxPooledSize + 1;
+    void *chunk = mem_pool::allocate(size);
+    std::memset(chunk, 0, size);
+    mem_pool::deallocate(chunk, size);
+
+    mem_pool::deallocate(nullptr, size);
+    mem_pool::deallocate(nullptr, 64);
+}
+
+TEST(MemPoolTest, ChunksReturnToTheirThread)
+{
+    void *chunk = mem_pool::allocate(128);
+
+    // The chunk does not join the freelists of the other thread
+    void *other_chunk = nullptr;
+    std::thread other([&]() {
+        mem_pool::deallocate(chunk, 128);
+        other_chunk = mem_pool::allocate(128);
+        mem_pool::deallocate(other_chunk, 128);
+    });
+    other.join();
+    EXPECT_NE(other_chunk, chunk);
+
+    // The thread that allocated it gets it back once its freelist runs out
+    std::vector<void *> chunks;
+    bool reused = false;
+    while (!reused && chunks.size() < 2 * mem_pool::slabSize / 128) {
+        chunks.push_back(mem_pool::allocate(128));
+        reused = chunks.back() == chunk;
+    }
+    EXPECT_TRUE(reused);
+
+    for (void *p : chunks)
+        mem_pool::deallocate(p, 128);
+}
+
+TEST(MemPoolTest, AllocateShared)
+{
+    struct Payload
+    {
+        uint64_t words[8];
+    };
+
+    std::weak_ptr<Payload> weak;
+    {
+        auto ptr = std::allocate_shared<Payload>(
+            mem_pool::Allocator<Payload>());
+        ptr->words[7] = 42;
+        weak = ptr;
+        EXPECT_EQ(weak.lock()->words[7], 42);
+    }
+    EXPECT_TRUE(weak.expired());
+}
@@ -59,7 +59,9 @@
 #include "base/logging.hh"
 #include "base/printable.hh"
 #include "base/types.hh"
+#include "config/use_mem_pool.hh"
 #include "mem/htm.hh"
+#include "mem/mem_pool.hh"
 #include "mem/request.hh"
 #include "sim/byteswap.hh"
 
@@ -350,6 +352,9 @@ class Packet : public Printable
         /// the packet is destroyed. The pointer is assumed to be pointing
         /// to an array, and delete [] is consequently called
         DYNAMIC_DATA           = 0x00002000,
+        /// The dynamic data was allocated from the memory pool, and
+        /// goes back to it when the packet is destroyed
+        POOLED_DATA            = 0x00004000,
 
         /// suppress the error if this packet encounters a functional
         /// access failure.
@@ -852,6 +857,23 @@ class Packet : public Printable
         cmd = MemCmd::ReadReq;
     }
 
+#if USE_MEM_POOL
+    /**
+     * Packets are allocated from the memory pool of the thread.
+     */
+    static void *
+    operator new(size_t size)
+    {
+        return mem_pool::allocate(size);
+    }
+
+    static void
+    operator delete(void *p, size_t size)
+    {
+        mem_pool::deallocate(p, size);
+    }
+#endif
+
     /**
      * Constructor. Note that a Request object must be constructed
      * first, but the Requests's physical address and size fields need
@@ -1327,10 +1349,12 @@ class Packet : public Printable
     void
     deleteData()
     {
-        if (flags.isSet(DYNAMIC_DATA))
+        if (flags.isSet(POOLED_DATA))
+            mem_pool::deallocate(data, getSize());
+        else if (flags.isSet(DYNAMIC_DATA))
             delete [] data;
 
-        flags.clear(STATIC_DATA|DYNAMIC_DATA);
+        flags.clear(STATIC_DATA|DYNAMIC_DATA|POOLED_DATA);
         data = NULL;
     }
 
@@ -1343,7 +1367,12 @@ class Packet : public Printable
         if (hasData() || hasRespData()) {
             assert(flags.noneSet(STATIC_DATA|DYNAMIC_DATA));
             flags.set(DYNAMIC_DATA);
+#if USE_MEM_POOL
+            flags.set(POOLED_DATA);
+            data = static_cast<uint8_t *>(mem_pool::allocate(getSize()));
+#else
             data = new uint8_t[getSize()];
+#endif
         }
     }
 
@@ -54,14 +54,17 @@
 #include <functional>
 #include <limits>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "base/amo.hh"
 #include "base/compiler.hh"
 #include "base/flags.hh"
 #include "base/types.hh"
+#include "config/use_mem_pool.hh"
 #include "cpu/inst_seq.hh"
 #include "mem/htm.hh"
+#include "mem/mem_pool.hh"
 #include "sim/cur_tick.hh"
 
 namespace gem5
@@ -191,6 +194,13 @@ class Request
         INVALIDATE                  = 0x0000000100000000,
         /** The request cleans a memory location */
         CLEAN                       = 0x0000000200000000,
+        /**
+         * The request is a writeback that is part of a batch of
+         * writebacks to the same memory region (e.g. a DBI region
+         * flush), and the memory controller may drain the batch
+         * back-to-back in the open row.
+         */
+        ROW_BATCH                   = 0x0000000400000000,
 
         /** The request targets the point of unification */
         DST_POU                     = 0x0000001000000000,
@@ -522,6 +532,23 @@ class Request
 
     ~Request() {}
 
+    /**
+     * Factory method for creating requests with any of the
+     * constructors. When gem5 is built with USE_MEM_POOL, the request
+     * and its reference count are allocated from the memory pool.
+     */
+    template <typename... Args>
+    static RequestPtr
+    create(Args&&... args)
+    {
+#if USE_MEM_POOL
+        return std::allocate_shared<Request>(mem_pool::Allocator<Request>(),
+                                             std::forward<Args>(args)...);
+#else
+        return std::make_shared<Request>(std::forward<Args>(args)...);
+#endif
+    }
+
     /**
      * Factory method for creating memory management requests, with
      * unspecified addr and size.
@@ -529,7 +556,7 @@ class Request
     static RequestPtr
     createMemManagement(Flags flags, RequestorID id)
     {
-        auto mgmt_req = std::make_shared<Request>();
+        auto mgmt_req = create();
         mgmt_req->_flags.set(flags);
         mgmt_req->_requestorId = id;
         mgmt_req->_time = curTick();
@@ -1023,6 +1050,7 @@ class Request
     }
     bool isSecure() const { return _flags.isSet(SECURE); }
     bool isPTWalk() const { return _flags.isSet(PT_WALK); }
+    bool isRowBatch() const { return _flags.isSet(ROW_BATCH); }
     bool isRelease() const { return _flags.isSet(RELEASE); }
     bool isKernel() const { return _flags.isSet(KERNEL); }
     bool isAtomicReturn() const { return _flags.isSet(ATOMIC_RETURN_OP); }
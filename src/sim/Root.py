@@ -30,6 +30,10 @@ from m5.SimObject import SimObject
 from m5.params import *
 from m5.util import fatal
 
+# Structure sorting the events of the main event queues, see
+# EventQueue::Backend. Both service the events in the same order.
+class EventQueueBackend(Enum): vals = ['list', 'calendar']
+
 class Root(SimObject):
 
     _the_instance = None
@@ -67,6 +71,9 @@ class Root(SimObject):
     # Needs to be set explicitly for a multi-eventq simulation.
     sim_quantum = Param.Tick(0, "simulation quantum")
 
+    eventq_backend = Param.EventQueueBackend('list',
+        "Structure sorting the events of the main event queues")
+
     full_system = Param.Bool("if this is a full system simulation")
 
     # Time syncing prevents the simulation from running faster than real time.
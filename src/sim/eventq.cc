@@ -37,6 +37,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "cpu/smt.hh"
@@ -57,6 +58,7 @@ uint32_t numMainEventQueues = 0;
 std::vector<EventQueue *> mainEventQueue;
 __thread EventQueue *_curEventQueue = NULL;
 bool inParallelMode = false;
+EventQueue::Backend mainEventQueueBackend = EventQueue::Backend::List;
 
 EventQueue *
 getEventQueue(uint32_t index)
@@ -64,7 +66,8 @@ getEventQueue(uint32_t index)
     while (numMainEventQueues <= index) {
         numMainEventQueues++;
         mainEventQueue.push_back(
-            new EventQueue(csprintf("MainEventQueue-%d", index)));
+            new EventQueue(csprintf("MainEventQueue-%d", index),
+                           mainEventQueueBackend));
     }
 
     return mainEventQueue[index];
@@ -111,6 +114,12 @@ Event::insertBefore(Event *event, Event *curr)
 void
 EventQueue::insert(Event *event)
 {
+    if (_backend == Backend::Calendar) {
+        calendar.insert(event);
+        head = calendar.head();
+        return;
+    }
+
     // Deal with the head case
     if (!head || *event <= *head) {
         head = Event::insertBefore(event, head);
@@ -170,6 +179,12 @@ EventQueue::remove(Event *event)
 
     assert(event->queue == this);
 
+    if (_backend == Backend::Calendar) {
+        calendar.remove(event);
+        head = calendar.head();
+        return;
+    }
+
     // deal with an event on the head's 'in bin' list (event has the same
     // time as the head)
     if (*head == *event) {
@@ -202,7 +217,10 @@ EventQueue::serviceOne()
     Event *next = head->nextInBin;
     event->flags.clear(Event::Scheduled);
 
-    if (next) {
+    if (_backend == Backend::Calendar) {
+        calendar.pop();
+        head = calendar.head();
+    } else if (next) {
         // update the next bin pointer since it could be stale
         next->nextBin = head->nextBin;
 
@@ -295,15 +313,12 @@ EventQueue::dump() const
     if (empty())
         cprintf("<No Events>\n");
     else {
-        Event *nextBin = head;
-        while (nextBin) {
+        for (Event *nextBin : bins()) {
             Event *nextInBin = nextBin;
             while (nextInBin) {
                 nextInBin->dump();
                 nextInBin = nextInBin->nextInBin;
             }
-
-            nextBin = nextBin->nextBin;
         }
     }
 
@@ -316,10 +331,9 @@ EventQueue::debugVerify() const
     std::unordered_map<long, bool> map;
 
     Tick time = 0;
-    short priority = 0;
+    short priority = Event::Minimum_Pri;
 
-    Event *nextBin = head;
-    while (nextBin) {
+    for (Event *nextBin : bins()) {
         Event *nextInBin = nextBin;
         while (nextInBin) {
             if (nextInBin->when() < time) {
@@ -345,21 +359,299 @@ EventQueue::debugVerify() const
 
             nextInBin = nextInBin->nextInBin;
         }
-
-        nextBin = nextBin->nextBin;
     }
 
     return true;
 }
 
+std::vector<Event *>
+EventQueue::bins() const
+{
+    if (_backend == Backend::Calendar)
+        return calendar.bins();
+
+    std::vector<Event *> list;
+    for (Event *nextBin = head; nextBin; nextBin = nextBin->nextBin)
+        list.push_back(nextBin);
+    return list;
+}
+
 Event*
 EventQueue::replaceHead(Event* s)
 {
+    // The events are handed over as a list of bins whatever the
+    // backend, so that they can be put back with either
+    if (_backend == Backend::Calendar) {
+        Event* t = calendar.release();
+        calendar.load(s);
+        head = calendar.head();
+        return t;
+    }
+
     Event* t = head;
     head = s;
     return t;
 }
 
+void
+EventQueue::setBackend(Backend backend)
+{
+    if (backend == _backend)
+        return;
+
+    Event *list = _backend == Backend::Calendar ? calendar.release() : head;
+    _backend = backend;
+    if (_backend == Backend::Calendar) {
+        calendar.load(list);
+        head = calendar.head();
+    } else {
+        head = list;
+    }
+}
+
+EventCalendar::EventCalendar()
+    : buckets(minBuckets, nullptr), bucketMask(minBuckets - 1),
+      widthShift(initialWidthShift), numBins(0), minBin(nullptr),
+      minSlot(0), ops(0), cost(0)
+{
+}
+
+void
+EventCalendar::insert(Event *event)
+{
+    // Find the bin of the event in its bucket, or where a new bin
+    // needs to be inserted, like EventQueue::insert()
+    Event *&bucket = buckets[bucketOf(event->when())];
+    Event *prev = nullptr;
+    Event *curr = bucket;
+    uint64_t walked = 0;
+    while (curr && *curr < *event) {
+        prev = curr;
+        curr = curr->nextBin;
+        walked++;
+    }
+
+    const bool new_bin = !curr || *event < *curr;
+    Event *top = Event::insertBefore(event, curr);
+    if (prev)
+        prev->nextBin = top;
+    else
+        bucket = top;
+
+    // An event of the earliest bin goes on top of it
+    if (!minBin || *event <= *minBin) {
+        minBin = event;
+        minSlot = event->when() >> widthShift;
+    }
+
+    if (new_bin && ++numBins > 2 * buckets.size()) {
+        resize(2 * buckets.size());
+        return;
+    }
+
+    account(walked);
+}
+
+void
+EventCalendar::remove(Event *event)
+{
+    Event *&bucket = buckets[bucketOf(event->when())];
+    Event *prev = nullptr;
+    Event *curr = bucket;
+    uint64_t walked = 0;
+    while (curr && *curr < *event) {
+        prev = curr;
+        curr = curr->nextBin;
+        walked++;
+    }
+
+    if (!curr || *curr != *event)
+        panic("event not found!");
+
+    Event *top = Event::removeItem(event, curr);
+    if (prev)
+        prev->nextBin = top;
+    else
+        bucket = top;
+
+    if (top && *top == *event) {
+        // The bin is still there, maybe with another event on top
+        if (*event == *minBin)
+            minBin = top;
+    } else {
+        numBins--;
+        if (numBins < buckets.size() / 2 && buckets.size() > minBuckets) {
+            resize(buckets.size() / 2);
+            return;
+        }
+        if (*event == *minBin)
+            findMin();
+    }
+
+    account(walked);
+}
+
+void
+EventCalendar::pop()
+{
+    Event *event = minBin;
+    Event *&bucket = buckets[bucketOf(event->when())];
+    assert(bucket == event);
+
+    // The earliest bin is the first one of its bucket
+    Event *next = event->nextInBin;
+    if (next) {
+        next->nextBin = event->nextBin;
+        bucket = next;
+        minBin = next;
+        return;
+    }
+
+    bucket = event->nextBin;
+    numBins--;
+    if (numBins < buckets.size() / 2 && buckets.size() > minBuckets) {
+        resize(buckets.size() / 2);
+        return;
+    }
+
+    findMin();
+    account(0);
+}
+
+void
+EventCalendar::findMin()
+{
+    if (numBins == 0) {
+        minBin = nullptr;
+        return;
+    }
+
+    // No bin is earlier than the previous earliest one, so the first
+    // bin of the current year found from its bucket on is the earliest
+    Tick slot = minSlot;
+    for (size_t walked = 0; walked < buckets.size(); walked++, slot++) {
+        Event *bin = buckets[slot & bucketMask];
+        if (bin && (bin->when() >> widthShift) == slot) {
+            minBin = bin;
+            minSlot = slot;
+            cost += walked;
+            return;
+        }
+    }
+
+    // A whole year without a bin, the bins are too sparse for the
+    // bucket width
+    Event *earliest = nullptr;
+    for (Event *bin : buckets) {
+        if (bin && (!earliest || *bin < *earliest))
+            earliest = bin;
+    }
+    minBin = earliest;
+    minSlot = earliest->when() >> widthShift;
+    cost += 2 * buckets.size();
+}
+
+void
+EventCalendar::account(uint64_t walked)
+{
+    cost += walked;
+    if (++ops < 4 * buckets.size())
+        return;
+
+    if (cost > maxCostPerOp * ops)
+        resize(buckets.size());
+    ops = cost = 0;
+}
+
+std::vector<Event *>
+EventCalendar::bins() const
+{
+    std::vector<Event *> sorted;
+    sorted.reserve(numBins);
+    for (Event *bin : buckets) {
+        for (; bin; bin = bin->nextBin)
+            sorted.push_back(bin);
+    }
+    std::sort(sorted.begin(), sorted.end(),
+              [](const Event *a, const Event *b) { return *a < *b; });
+    return sorted;
+}
+
+void
+EventCalendar::rebuild(const std::vector<Event *> &sorted,
+                       size_t num_buckets)
+{
+    // Like Brown, make a bucket about three times the average spacing of
+    // the bins about to be serviced, leaving out the spacings that are
+    // much larger than the average
+    const size_t samples = std::min(sorted.size(), widthSamples + 1);
+    Tick width = 1;
+    if (samples > 1) {
+        const Tick span = sorted[samples - 1]->when() - sorted[0]->when();
+        const Tick average = span / (samples - 1);
+        Tick kept_span = 0;
+        size_t kept = 0;
+        for (size_t i = 1; i < samples; i++) {
+            const Tick spacing = sorted[i]->when() - sorted[i - 1]->when();
+            if (spacing / 2 <= average) {
+                kept_span += spacing;
+                kept++;
+            }
+        }
+        width = std::max<Tick>(std::min(kept_span / kept, maxWidth / 3) * 3,
+                               1);
+    } else {
+        width = Tick(1) << widthShift;
+    }
+    widthShift = ceilLog2(width);
+
+    buckets.assign(num_buckets, nullptr);
+    bucketMask = num_buckets - 1;
+
+    // Push the bins in reverse order, so that each bucket ends up sorted
+    for (auto bin = sorted.rbegin(); bin != sorted.rend(); ++bin) {
+        Event *&bucket = buckets[bucketOf((*bin)->when())];
+        (*bin)->nextBin = bucket;
+        bucket = *bin;
+    }
+
+    numBins = sorted.size();
+    minBin = sorted.empty() ? nullptr : sorted.front();
+    minSlot = minBin ? minBin->when() >> widthShift : 0;
+    ops = cost = 0;
+}
+
+Event *
+EventCalendar::release()
+{
+    std::vector<Event *> sorted = bins();
+    for (size_t i = 0; i < sorted.size(); i++)
+        sorted[i]->nextBin = i + 1 < sorted.size() ? sorted[i + 1] : nullptr;
+
+    std::fill(buckets.begin(), buckets.end(), nullptr);
+    numBins = 0;
+    minBin = nullptr;
+    minSlot = 0;
+    ops = cost = 0;
+
+    return sorted.empty() ? nullptr : sorted.front();
+}
+
+void
+EventCalendar::load(Event *list)
+{
+    assert(empty());
+
+    std::vector<Event *> sorted;
+    for (Event *bin = list; bin; bin = bin->nextBin)
+        sorted.push_back(bin);
+
+    size_t num_buckets = minBuckets;
+    while (num_buckets < sorted.size())
+        num_buckets *= 2;
+    rebuild(sorted, num_buckets);
+}
+
 void
 dumpMainQueue()
 {
@@ -415,8 +707,8 @@ Event::dump() const
     }
 }
 
-EventQueue::EventQueue(const std::string &n)
-    : objName(n), head(NULL), _curTick(0)
+EventQueue::EventQueue(const std::string &n, Backend backend)
+    : objName(n), head(NULL), _curTick(0), _backend(backend)
 {
 }
 
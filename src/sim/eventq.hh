@@ -43,6 +43,7 @@
 #include <list>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/debug.hh"
 #include "base/flags.hh"
@@ -56,6 +57,7 @@ namespace gem5
 {
 
 class EventQueue;       // forward declaration
+class EventCalendar;
 class BaseGlobalEvent;
 
 //! Simulation Quantum for multiple eventq simulation.
@@ -251,6 +253,7 @@ class EventBase
 class Event : public EventBase, public Serializable
 {
     friend class EventQueue;
+    friend class EventCalendar;
 
   private:
     // The event queue is now a linked list of linked lists.  The
@@ -261,7 +264,9 @@ class Event : public EventBase, public Serializable
     // result is that the insert/removal in 'nextBin' is
     // linear/constant, and the lookup/removal in 'nextInBin' is
     // constant/constant.  Hopefully this is a significant improvement
-    // over the current fully linear insertion.
+    // over the current fully linear insertion.  With the calendar
+    // backend, the bins are spread over the buckets of an
+    // EventCalendar, and 'nextBin' links the bins of a bucket.
     Event *nextBin;
     Event *nextInBin;
 
@@ -581,6 +586,116 @@ operator!=(const Event &l, const Event &r)
     return l.when() != r.when() || l.priority() != r.priority();
 }
 
+/**
+ * Calendar queue of event bins, after R. Brown, "Calendar Queues: A Fast
+ * O(1) Priority Queue Implementation for the Simulation Event Set
+ * Problem", CACM 31(10), 1988.
+ *
+ * The bins (events with the same when and priority, stacked through
+ * nextInBin) are hashed by tick into buckets. A bucket covers
+ * 2^widthShift consecutive ticks every year, a year being as many
+ * bucket widths as there are buckets, and keeps its bins sorted through
+ * nextBin. Insertion and removal only walk the bins of one bucket.
+ * Finding the next bin walks the buckets from the current one until it
+ * finds a bin of the current year, falling back on a search of all the
+ * buckets after a year without any.
+ *
+ * The number of buckets follows the number of bins. The bucket width
+ * is picked from the spacing of the bins at the front of the queue,
+ * whenever the buckets are resized, or when the queue spends too long
+ * walking buckets.
+ *
+ * The bins are only manipulated with Event::insertBefore() and
+ * Event::removeItem(), so the order of the events of a bin, and hence
+ * the order in which the events are serviced, is the same as the one
+ * of the list of bins of EventQueue.
+ */
+class EventCalendar
+{
+  private:
+    /** Smallest number of buckets. */
+    static const size_t minBuckets = 64;
+
+    /** Log2 of the bucket width before the first resize. */
+    static const unsigned initialWidthShift = 10;
+
+    /**
+     * Largest bucket width, so that the bins far in the future, such as
+     * the exit event at MaxTick, do not make it overflow.
+     */
+    static const Tick maxWidth = Tick(1) << 48;
+
+    /** Number of bins at the front the bucket width is picked from. */
+    static const size_t widthSamples = 64;
+
+    /**
+     * Buckets walked per operation, on average, above which the bucket
+     * width is picked again.
+     */
+    static const uint64_t maxCostPerOp = 8;
+
+    /** First bin of each bucket. */
+    std::vector<Event *> buckets;
+    size_t bucketMask;
+    unsigned widthShift;
+
+    /** Number of bins in the calendar. */
+    size_t numBins;
+
+    /** Earliest bin, and its bucket in the unwrapped calendar. */
+    Event *minBin;
+    Tick minSlot;
+
+    /** Operations and bins walked since the bucket width was picked. */
+    uint64_t ops;
+    uint64_t cost;
+
+    size_t bucketOf(Tick when) const
+    {
+        return (when >> widthShift) & bucketMask;
+    }
+
+    /** Find the earliest bin, after the previous one went away. */
+    void findMin();
+
+    /** Account for an operation that walked a number of bins. */
+    void account(uint64_t walked);
+
+    /**
+     * Spread sorted bins over a number of buckets, picking the bucket
+     * width from their spacing.
+     */
+    void rebuild(const std::vector<Event *> &sorted, size_t num_buckets);
+
+    void resize(size_t num_buckets) { rebuild(bins(), num_buckets); }
+
+  public:
+    EventCalendar();
+
+    bool empty() const { return minBin == nullptr; }
+
+    /** The first event of the earliest bin. */
+    Event *head() const { return minBin; }
+
+    void insert(Event *event);
+    void remove(Event *event);
+
+    /** Remove the first event of the earliest bin. */
+    void pop();
+
+    /** The first event of every bin, in time order. */
+    std::vector<Event *> bins() const;
+
+    /**
+     * Empty the calendar, returning its bins linked in time order
+     * through nextBin, like the list of bins of EventQueue.
+     */
+    Event *release();
+
+    /** Fill an empty calendar with a list of bins, like release(). */
+    void load(Event *list);
+};
+
 /**
  * Queue of events sorted in time order
  *
@@ -618,16 +733,37 @@ operator!=(const Event &l, const Event &r)
  * events must happen at least one simulation quantum into the future,
  * otherwise they risk being scheduled in the past by
  * handleAsyncInsertions().
+ *
+ * The bins of events are either kept in a sorted list, where insertion
+ * is linear in the number of bins, or in an EventCalendar, where it is
+ * constant on average. Both service the events in the same order, see
+ * setBackend().
  */
 class EventQueue
 {
+  public:
+    /** Structure sorting the bins of events. */
+    enum class Backend
+    {
+        List,
+        Calendar
+    };
+
   private:
     friend void curEventQueue(EventQueue *);
 
     std::string objName;
+
+    /**
+     * First event of the earliest bin. With the list backend, the bins
+     * are linked from it through nextBin.
+     */
     Event *head;
     Tick _curTick;
 
+    Backend _backend;
+    EventCalendar calendar;
+
     //! Mutex to protect async queue.
     UncontendedMutex async_queue_mutex;
 
@@ -661,6 +797,9 @@ class EventQueue
     void insert(Event *event);
     void remove(Event *event);
 
+    //! The first event of every bin, in time order.
+    std::vector<Event *> bins() const;
+
     //! Function for adding events to the async queue. The added events
     //! are added to main event queue later. Threads, other than the
     //! owning thread, should call this function instead of insert().
@@ -745,7 +884,7 @@ class EventQueue
     /**
      * @ingroup api_eventq
      */
-    EventQueue(const std::string &n);
+    EventQueue(const std::string &n, Backend backend=Backend::List);
 
     /**
      * @ingroup api_eventq
@@ -939,6 +1078,15 @@ class EventQueue
      */
     Event* replaceHead(Event* s);
 
+    /**
+     * Change the structure sorting the bins, moving the scheduled
+     * events over. The events are serviced in the same order with
+     * either backend: by tick, then by priority, then the last scheduled
+     * first. Should be called only from the owning thread.
+     */
+    void setBackend(Backend backend);
+    Backend backend() const { return _backend; }
+
     /**@{*/
     /**
      * Provide an interface for locking/unlocking the event queue.
@@ -982,6 +1130,9 @@ curEventQueue(EventQueue *q)
     Gem5Internal::_curTickPtr = (q == nullptr) ? nullptr : &q->_curTick;
 }
 
+//! Backend of the main event queues allocated by getEventQueue().
+extern EventQueue::Backend mainEventQueueBackend;
+
 void dumpMainQueue();
 
 class EventManager
@@ -0,0 +1,223 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "sim/eventq.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** An event that logs its id when it is serviced. */
+class LogEvent : public Event
+{
+  public:
+    LogEvent(int _id, std::vector<int> &_log, Priority p)
+        : Event(p), id(_id), log(_log)
+    {}
+
+    void process() override { log.push_back(id); }
+
+    const int id;
+
+  private:
+    std::vector<int> &log;
+};
+
+/** An event queue and its events, logging the order of service. */
+struct Harness
+{
+    // The events outlive the queue, which deschedules them
+    std::vector<std::unique_ptr<LogEvent>> events;
+    std::vector<int> log;
+    EventQueue eq;
+
+    Harness(EventQueue::Backend backend, int num_events,
+            const std::vector<Event::Priority> &priorities)
+        : eq("test", backend)
+    {
+        for (int i = 0; i < num_events; i++) {
+            events.emplace_back(new LogEvent(i, log,
+                priorities[i % priorities.size()]));
+        }
+    }
+
+    void
+    drain()
+    {
+        while (!eq.empty())
+            eq.serviceOne();
+    }
+};
+
+const std::vector<Event::Priority> priorities = {
+    Event::Default_Pri, Event::CPU_Tick_Pri, Event::Delayed_Writeback_Pri,
+    Event::Default_Pri, Event::Stat_Event_Pri, Event::Default_Pri
+};
+
+/** Delay of an event, with many events sharing the same ticks. */
+Tick
+randomDelay(std::mt19937_64 &rng)
+{
+    switch (rng() % 4) {
+      case 0:
+        return 0;
+      case 1:
+        return 500 * (rng() % 4);
+      case 2:
+        return rng() % 64;
+      default:
+        return rng() % 1000000;
+    }
+}
+
+} // anonymous namespace
+
+/**
+ * Schedule, reschedule, deschedule and service the same events on a list
+ * and on a calendar, and check that they are serviced in the same order.
+ */
+TEST(EventQueueTest, CalendarServicesInListOrder)
+{
+    const int num_events = 4096;
+    Harness list(EventQueue::Backend::List, num_events, priorities);
+    Harness calendar(EventQueue::Backend::Calendar, num_events, priorities);
+    std::mt19937_64 rng(1);
+
+    for (int step = 0; step < 200000; step++) {
+        const int id = rng() % num_events;
+        Event *list_event = list.events[id].get();
+        Event *cal_event = calendar.events[id].get();
+        const Tick when = list.eq.getCurTick() + randomDelay(rng);
+
+        switch (rng() % 8) {
+          case 0:
+          case 1:
+          case 2:
+            if (!list_event->scheduled()) {
+                list.eq.schedule(list_event, when);
+                calendar.eq.schedule(cal_event, when);
+            }
+            break;
+          case 3:
+            list.eq.reschedule(list_event, when, true);
+            calendar.eq.reschedule(cal_event, when, true);
+            break;
+          case 4:
+            if (list_event->scheduled()) {
+                list.eq.deschedule(list_event);
+                calendar.eq.deschedule(cal_event);
+            }
+            break;
+          default:
+            if (!list.eq.empty()) {
+                list.eq.serviceOne();
+                calendar.eq.serviceOne();
+            }
+            break;
+        }
+
+        ASSERT_EQ(list.eq.empty(), calendar.eq.empty());
+        if (!list.eq.empty()) {
+            ASSERT_EQ(list.eq.nextTick(), calendar.eq.nextTick());
+            ASSERT_EQ(static_cast<LogEvent *>(list.eq.getHead())->id,
+                      static_cast<LogEvent *>(calendar.eq.getHead())->id);
+        }
+        ASSERT_EQ(list.eq.getCurTick(), calendar.eq.getCurTick());
+    }
+
+    list.drain();
+    calendar.drain();
+    ASSERT_FALSE(list.log.empty());
+    EXPECT_EQ(list.log, calendar.log);
+    EXPECT_TRUE(calendar.eq.debugVerify());
+}
+
+/** Events of a bin are serviced last scheduled first, with both backends. */
+TEST(EventQueueTest, SameBinIsLastInFirstOut)
+{
+    Harness calendar(EventQueue::Backend::Calendar, 4, {0});
+
+    for (auto &event : calendar.events)
+        calendar.eq.schedule(event.get(), 100);
+    calendar.drain();
+
+    EXPECT_EQ(calendar.log, std::vector<int>({3, 2, 1, 0}));
+}
+
+/** Switching backends keeps the scheduled events and their order. */
+TEST(EventQueueTest, SetBackend)
+{
+    const int num_events = 2048;
+    Harness list(EventQueue::Backend::List, num_events, priorities);
+    Harness mixed(EventQueue::Backend::List, num_events, priorities);
+    std::mt19937_64 rng(2);
+
+    for (int id = 0; id < num_events; id++) {
+        const Tick when = randomDelay(rng);
+        list.eq.schedule(list.events[id].get(), when);
+        mixed.eq.schedule(mixed.events[id].get(), when);
+    }
+
+    for (int i = 0; i < num_events; i++) {
+        if (i % 500 == 0) {
+            mixed.eq.setBackend(
+                mixed.eq.backend() == EventQueue::Backend::List ?
+                EventQueue::Backend::Calendar : EventQueue::Backend::List);
+            ASSERT_TRUE(mixed.eq.debugVerify());
+        }
+        list.eq.serviceOne();
+        mixed.eq.serviceOne();
+    }
+
+    EXPECT_TRUE(mixed.eq.empty());
+    EXPECT_EQ(list.log, mixed.log);
+}
+
+/** The events taken out by replaceHead() can be put back. */
+TEST(EventQueueTest, CalendarReplaceHead)
+{
+    Harness calendar(EventQueue::Backend::Calendar, 3, {0});
+
+    calendar.eq.schedule(calendar.events[0].get(), 300);
+    calendar.eq.schedule(calendar.events[1].get(), 100);
+    Event *saved = calendar.eq.replaceHead(nullptr);
+    EXPECT_TRUE(calendar.eq.empty());
+
+    calendar.eq.schedule(calendar.events[2].get(), 200);
+    calendar.drain();
+    calendar.eq.setCurTick(0);
+
+    EXPECT_EQ(calendar.eq.replaceHead(saved), nullptr);
+    calendar.drain();
+
+    EXPECT_EQ(calendar.log, std::vector<int>({2, 1, 0}));
+}
+
+/**
+ * Events far apart, up to MaxTick, and a queue that grows and shrinks,
+ * making the calendar resize its buckets.
+ */
+TEST(EventQueueTest, CalendarSparseAndResized)
+{
+    const int num_events = 10000;
+    Harness list(EventQueue::Backend::List, num_events, priorities);
+    Harness calendar(EventQueue::Backend::Calendar, num_events, priorities);
+    std::mt19937_64 rng(3);
+
+    list.eq.schedule(list.events[0].get(), MaxTick);
+    calendar.eq.schedule(calendar.events[0].get(), MaxTick);
+    for (int id = 1; id < num_events; id++) {
+        const Tick when = id % 3 ? rng() % 100000 : rng() >> (1 + rng() % 63);
+        list.eq.schedule(list.events[id].get(), when);
+        calendar.eq.schedule(calendar.events[id].get(), when);
+    }
+
+    list.drain();
+    calendar.drain();
+    EXPECT_EQ(list.log, calendar.log);
+    EXPECT_EQ(calendar.log.back(), 0);
+}
@@ -0,0 +1,240 @@
+/**
+ * @file
+ * Host throughput benchmark of the event queue backends.
+ *
+ * Services the same synthetic event mix with the list and the calendar
+ * backends of EventQueue, and reports the number of events per second.
+ * The mix follows what a many-core system with a network and DRAM
+ * schedules:
+ *
+ * - Clocked objects (cores, routers, controllers) that tick every cycle
+ *   of their clock, on the clock edges, so that many events share a
+ *   tick. A quarter of them are cores, ticking at CPU_Tick_Pri.
+ * - Outstanding transactions (cache hits, network hops, DRAM accesses)
+ *   that each start another one when they complete, after a latency of
+ *   a few cycles, tens of cycles or a DRAM access.
+ * - Watchdogs (retry and deadlock timers) that every completed
+ *   transaction pushes back, as reschedules far in the future.
+ *
+ * Both backends must service the events in the same order, which is
+ * checked with a hash of the order of service.
+ *
+ * Usage: eventq_bench [-c clocked objects] [-t transactions]
+ *                     [-w watchdogs] [-n events] [-b list|calendar|both]
+ */
+
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "sim/eventq.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+struct MixParams
+{
+    unsigned clocked = 256;
+    unsigned transactions = 4096;
+    unsigned watchdogs = 64;
+    uint64_t events = 10000000;
+};
+
+/** The events of a mix, scheduled on one queue. */
+class Mix
+{
+  private:
+    static const Tick transactionClock = 500;
+    static const Tick watchdogTimeout = 1000000;
+
+    EventQueue &eq;
+    std::mt19937_64 rng;
+    std::vector<std::unique_ptr<EventFunctionWrapper>> clocked;
+    std::vector<std::unique_ptr<EventFunctionWrapper>> transactions;
+    std::vector<std::unique_ptr<EventFunctionWrapper>> watchdogs;
+
+    /** FNV-1a hash of the order of service. */
+    uint64_t hash;
+
+    void
+    serviced(uint64_t id)
+    {
+        hash = (hash ^ id) * 0x100000001b3ULL;
+    }
+
+    /** Latency of a transaction, on the clock edges. */
+    Tick
+    latency()
+    {
+        const unsigned kind = rng() % 10;
+        Tick cycles;
+        if (kind < 6)
+            cycles = 1 + rng() % 4;
+        else if (kind < 9)
+            cycles = 10 + rng() % 30;
+        else
+            cycles = 100 + rng() % 140;
+        return cycles * transactionClock;
+    }
+
+    void
+    completeTransaction(unsigned index)
+    {
+        serviced(clocked.size() + index);
+
+        EventFunctionWrapper &watchdog =
+            *watchdogs[index % watchdogs.size()];
+        eq.reschedule(&watchdog, eq.getCurTick() + watchdogTimeout, true);
+
+        eq.schedule(transactions[index].get(), eq.getCurTick() + latency());
+    }
+
+  public:
+    Mix(EventQueue &_eq, const MixParams &p)
+        : eq(_eq), rng(1), hash(0xcbf29ce484222325ULL)
+    {
+        // 3GHz and 2GHz cores, a 1GHz network and 800MHz controllers
+        static const Tick periods[] = { 333, 500, 1000, 1250 };
+
+        for (unsigned i = 0; i < p.clocked; i++) {
+            const Tick period = periods[i % 4];
+            const Event::Priority priority = i % 4 == 0 ?
+                Event::CPU_Tick_Pri : Event::Default_Pri;
+            clocked.emplace_back(new EventFunctionWrapper(
+                [this, i, period]() {
+                    serviced(i);
+                    eq.schedule(clocked[i].get(), eq.getCurTick() + period);
+                }, "clocked", false, priority));
+            eq.schedule(clocked[i].get(), period);
+        }
+
+        for (unsigned i = 0; i < p.watchdogs; i++) {
+            watchdogs.emplace_back(new EventFunctionWrapper(
+                [this, i]() { serviced(~uint64_t(i)); }, "watchdog"));
+        }
+
+        for (unsigned i = 0; i < p.transactions; i++) {
+            transactions.emplace_back(new EventFunctionWrapper(
+                [this, i]() { completeTransaction(i); }, "transaction"));
+            eq.schedule(transactions[i].get(), latency());
+        }
+    }
+
+    ~Mix()
+    {
+        while (!eq.empty())
+            eq.deschedule(eq.getHead());
+    }
+
+    uint64_t orderHash() const { return hash; }
+};
+
+struct Result
+{
+    double seconds;
+    uint64_t orderHash;
+    Tick lastTick;
+};
+
+Result
+run(EventQueue::Backend backend, const MixParams &p)
+{
+    EventQueue eq("bench", backend);
+    Mix mix(eq, p);
+
+    const auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < p.events; i++)
+        eq.serviceOne();
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    return { elapsed.count(), mix.orderHash(), eq.getCurTick() };
+}
+
+void
+report(const char *name, const Result &result, const MixParams &p)
+{
+    std::cout << name << ": " << result.seconds << " s, "
+              << p.events / result.seconds / 1e6 << " Mevents/s, "
+              << result.seconds * 1e9 / p.events << " ns/event"
+              << std::endl;
+}
+
+} // anonymous namespace
+
+int
+main(int argc, char **argv)
+{
+    MixParams p;
+    std::string backends = "both";
+
+    int opt;
+    while ((opt = getopt(argc, argv, "c:t:w:n:b:")) != -1) {
+        switch (opt) {
+          case 'c':
+            p.clocked = std::atoi(optarg);
+            break;
+          case 't':
+            p.transactions = std::atoi(optarg);
+            break;
+          case 'w':
+            p.watchdogs = std::atoi(optarg);
+            break;
+          case 'n':
+            p.events = std::strtoull(optarg, nullptr, 10);
+            break;
+          case 'b':
+            backends = optarg;
+            break;
+          default:
+            std::cerr << "Usage: " << argv[0] << " [-c clocked objects] "
+                      << "[-t transactions] [-w watchdogs] [-n events] "
+                      << "[-b list|calendar|both]" << std::endl;
+            return 1;
+        }
+    }
+
+    if (p.clocked + p.transactions == 0 || p.watchdogs == 0 ||
+        (backends != "list" && backends != "calendar" &&
+         backends != "both")) {
+        std::cerr << "Needs clocked objects or transactions, watchdogs, "
+                  << "and a backend of list, calendar or both" << std::endl;
+        return 1;
+    }
+
+    std::cout << p.clocked << " clocked objects, " << p.transactions
+              << " transactions, " << p.watchdogs << " watchdogs, "
+              << p.events << " events" << std::endl;
+
+    Result list, calendar;
+    if (backends != "calendar") {
+        list = run(EventQueue::Backend::List, p);
+        report("list", list, p);
+    }
+    if (backends != "list") {
+        calendar = run(EventQueue::Backend::Calendar, p);
+        report("calendar", calendar, p);
+    }
+
+    if (backends == "both") {
+        if (list.orderHash != calendar.orderHash ||
+            list.lastTick != calendar.lastTick) {
+            std::cerr << "The backends serviced the events in different "
+                      << "orders" << std::endl;
+            return 1;
+        }
+        std::cout << "Same order of service, speedup "
+                  << list.seconds / calendar.seconds << std::endl;
+    }
+
+    return 0;
+}
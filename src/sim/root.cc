@@ -188,6 +188,13 @@ Root::Root(const RootParams &p, int)
 
     simQuantum = p.sim_quantum;
 
+    // The queues allocated so far may already hold events, they are
+    // moved over to the new backend
+    mainEventQueueBackend = p.eventq_backend == enums::calendar ?
+        EventQueue::Backend::Calendar : EventQueue::Backend::List;
+    for (uint32_t i = 0; i < numMainEventQueues; i++)
+        mainEventQueue[i]->setBackend(mainEventQueueBackend);
+
     // Some of the statistics are global and need to be accessed by
     // stat formulas. The most convenient way to implement that is by
     // having a single global stat group for global stats. Merge that